@@ -0,0 +1,215 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <BinaryFile.h>
+
+#include <fstream>
+#include <string>
+
+#include <stdio.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char BinaryFile::_magic[ 8 ] = { 'B', 'S', 'C', 'A', 'E', 'R', 'O', '\0' };
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool BinaryFile::isBinaryFile( const char *file )
+{
+    char magic[ 8 ];
+
+    std::fstream fs( file, std::ios_base::in | std::ios_base::binary );
+
+    if ( !fs.is_open() ) return false;
+
+    fs.read( magic, sizeof(magic) );
+
+    return fs.gcount() == sizeof(magic) && memcmp( magic, _magic, sizeof(magic) ) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BinaryFile::BinaryFile()
+{
+    memset( &_header, 0, sizeof(_header) );
+
+    memcpy( _header.magic, _magic, sizeof(_magic) );
+    _header.version     = version;
+    _header.byte_order  = byteOrder;
+    _header.header_size = sizeof(Header);
+
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BinaryFile::~BinaryFile()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void BinaryFile::setArray( Array array, const double *data, size_t count )
+{
+    _data  [ array ] = const_cast< double* >( data );
+    _count [ array ] = count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool BinaryFile::write( const char *file )
+{
+    // arrays may be placed in the mapped file which is going to be replaced
+    std::string temp = std::string( file ) + ".tmp";
+
+    std::fstream fs( temp.c_str(), std::ios_base::out | std::ios_base::binary );
+
+    if ( !fs.is_open() ) return false;
+
+    Entry entries[ ArraysCount ];
+    uint32_t entries_count = 0;
+
+    for ( int i = 0; i < ArraysCount; i++ )
+    {
+        if ( _data[ i ] )
+        {
+            memset( &entries[ entries_count ], 0, sizeof(Entry) );
+            entries[ entries_count ].array = i;
+            entries[ entries_count ].count = _count[ i ];
+            entries_count++;
+        }
+    }
+
+    // arrays data is placed after header and arrays table
+    uint64_t offset = sizeof(Header) + entries_count * sizeof(Entry);
+
+    for ( uint32_t i = 0; i < entries_count; i++ )
+    {
+        offset = ( ( offset + alignment - 1 ) / alignment ) * alignment;
+        entries[ i ].offset = offset;
+        offset += entries[ i ].count * sizeof(double);
+    }
+
+    _header.arrays_count = entries_count;
+
+    fs.write( (const char*)&_header, sizeof(Header) );
+    fs.write( (const char*)entries, entries_count * sizeof(Entry) );
+
+    const char padding[ alignment ] = { 0 };
+    uint64_t position = sizeof(Header) + entries_count * sizeof(Entry);
+
+    for ( uint32_t i = 0; i < entries_count; i++ )
+    {
+        fs.write( padding, entries[ i ].offset - position );
+        fs.write( (const char*)_data[ entries[ i ].array ], entries[ i ].count * sizeof(double) );
+
+        position = entries[ i ].offset + entries[ i ].count * sizeof(double);
+    }
+
+    bool success = fs.good();
+
+    fs.close();
+
+    success = success && !fs.fail() && MappedFile::replace( temp.c_str(), file );
+
+    if ( !success ) remove( temp.c_str() );
+
+    return success;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool BinaryFile::open( const char *file )
+{
+    close();
+
+    if ( !_file.open( file ) ) return false;
+
+    const char *data = _file.getData();
+    size_t size = _file.getSize();
+
+    bool valid = size >= sizeof(Header);
+
+    if ( valid )
+    {
+        memcpy( &_header, data, sizeof(Header) );
+
+        valid = memcmp( _header.magic, _magic, sizeof(_magic) ) == 0
+             && _header.version     >= 1
+             && _header.version     <= version
+             && _header.byte_order  == byteOrder
+             && _header.header_size == sizeof(Header)
+             && _header.arrays_count <= ArraysCount
+             && size >= sizeof(Header) + _header.arrays_count * sizeof(Entry);
+    }
+
+    if ( valid )
+    {
+        const Entry *entries = (const Entry*)( data + sizeof(Header) );
+
+        for ( uint32_t i = 0; i < _header.arrays_count && valid; i++ )
+        {
+            const Entry &entry = entries[ i ];
+
+            // offset and number of elements are checked against file size
+            // in a way which cannot overflow
+            valid = entry.array < ArraysCount
+                 && entry.offset % sizeof(double) == 0
+                 && entry.offset <= size
+                 && entry.count <= ( size - entry.offset ) / sizeof(double);
+
+            if ( valid )
+            {
+                _data  [ entry.array ] = (double*)( _file.getData() + entry.offset );
+                _count [ entry.array ] = entry.count;
+            }
+        }
+    }
+
+    if ( !valid ) close();
+
+    return valid;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void BinaryFile::close()
+{
+    _file.close();
+
+    for ( int i = 0; i < ArraysCount; i++ )
+    {
+        _data  [ i ] = 0;
+        _count [ i ] = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double* BinaryFile::getArray( Array array, size_t count )
+{
+    if ( _count[ array ] != count ) return 0;
+
+    return _data[ array ];
+}
@@ -0,0 +1,177 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BINARYFILE_H
+#define BINARYFILE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <stdint.h>
+
+#include <MappedFile.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Versioned binary results file container.
+ *
+ * File consists of fixed size header, table of arrays entries (array id,
+ * offset and number of elements) and arrays data. Every array is stored as
+ * native double values aligned to the cache line size, so after memory-mapping
+ * the file arrays can be accessed in place without any parsing.
+ *
+ * File is mapped privately (copy-on-write), so data accessed in place can be
+ * modified without affecting the file.
+ */
+class BinaryFile
+{
+public:
+
+    static const uint32_t version   = 2;            ///< current format version (version 1 files are also read)
+    static const uint32_t byteOrder = 0x01020304;   ///< byte order mark
+    static const size_t   alignment = 64;           ///< [bytes] arrays alignment
+    static const int32_t  maxCount  = 1 << 20;      ///< maximum number of cross sections, angles of attack,
+                                                    ///< spanwise sections and Fourier series terms
+
+    /** File arrays. */
+    enum Array
+    {
+        SectionsData = 0,       ///< wing geometry input, 5 x sections
+        AngleOfAttackDeg,       ///< [aoa]
+        AngleOfAttackRad,       ///< [aoa]
+        Wingspan,               ///< [sections_fullspan]
+        ChordLength,            ///< [sections_fullspan]
+        LiftCurveSlope,         ///< [sections_fullspan]
+        AngleOf0LiftDeg,        ///< [sections_fullspan]
+        AngleOf0LiftRad,        ///< [sections_fullspan]
+        Phi,                    ///< [sections_fullspan]
+        Mu,                     ///< [sections_fullspan]
+        EquationsSpan,          ///< [fourier_accuracy]
+        EquationsLHS,           ///< [fourier_accuracy][fourier_accuracy]
+        EquationsRHS,           ///< [aoa][fourier_accuracy]
+        FourierTerms,           ///< [aoa][fourier_accuracy]
+        Gamma,                  ///< [aoa][sections_fullspan]
+        LiftCoefDist,           ///< [aoa][sections_fullspan]
+        VelocityDist,           ///< [aoa][sections_fullspan]
+        DragCoefDist,           ///< [aoa][sections_fullspan]
+        LiftCoef,               ///< [aoa]
+        DragCoef,               ///< [aoa]
+        ArraysCount             ///< number of arrays
+    };
+
+    /** File header. */
+    struct Header
+    {
+        char     magic[ 8 ];            ///< file signature
+        uint32_t version;               ///< format version
+        uint32_t byte_order;            ///< byte order mark
+        uint32_t header_size;           ///< [bytes] header size
+        uint32_t arrays_count;          ///< number of arrays entries
+
+        int32_t  sections;              ///< number of input cross sections
+        int32_t  aoa_iterations;        ///< number of angles of attack
+        int32_t  sections_iterations;   ///< number of spanwise sections
+        int32_t  fourier_accuracy;      ///< number of Fourier series terms
+        int32_t  results;               ///< specifies if results are stored
+        int32_t  modes;                 ///< compute modes results were computed in (zero in version 1)
+
+        double   aoa_start;             ///< [deg]
+        double   aoa_finish;            ///< [deg]
+        double   aoa_step;              ///< [deg]
+        double   fluid_velocity;        ///< [m/s]
+        double   fluid_density;         ///< [kg/m^3]
+    };
+
+    /** Arrays table entry. */
+    struct Entry
+    {
+        uint32_t array;                 ///< array id
+        uint32_t reserved;              ///< reserved (zero)
+        uint64_t offset;                ///< [bytes] array data offset from the file beginning
+        uint64_t count;                 ///< number of array elements
+    };
+
+    /** @return true if file begins with binary results file signature */
+    static bool isBinaryFile( const char *file );
+
+    /** @brief Constructor. */
+    BinaryFile();
+
+    /** @brief Destructor. Closes file. */
+    ~BinaryFile();
+
+    /** @brief Returns file header. */
+    Header& getHeader() { return _header; }
+
+    /**
+     * @brief Sets array to be written to file.
+     * @param array array id
+     * @param data array data
+     * @param count number of array elements
+     */
+    void setArray( Array array, const double *data, size_t count );
+
+    /**
+     * @brief Writes header and all set arrays to file. Data is written to
+     * temporary file first, which then replaces given file, so file which is
+     * currently mapped (e.g. the one arrays were read from) can be written.
+     * @param file file path
+     * @return true on success and false on failure
+     */
+    bool write( const char *file );
+
+    /**
+     * @brief Maps file into memory and validates header and arrays table.
+     * @param file file path
+     * @return true on success and false on failure
+     */
+    bool open( const char *file );
+
+    /** @brief Unmaps file and clears arrays. */
+    void close();
+
+    /**
+     * @brief Returns array data placed in mapped file.
+     * @param array array id
+     * @param count expected number of array elements
+     * @return array data or null address if array doesn't exist or its number of elements differs
+     */
+    double* getArray( Array array, size_t count );
+
+private:
+
+    static const char _magic[ 8 ];      ///< file signature
+
+    Header _header;                     ///< file header
+
+    double *_data[ ArraysCount ];       ///< arrays data
+    size_t _count[ ArraysCount ];       ///< arrays numbers of elements
+
+    MappedFile _file;                   ///< mapped file
+
+    BinaryFile( const BinaryFile & );
+    BinaryFile& operator=( const BinaryFile & );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BINARYFILE_H
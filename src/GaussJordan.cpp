@@ -22,15 +22,383 @@
 
 #include <GaussJordan.h>
 
+#include <algorithm>
+
+#include <ThreadPool.h>
+
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#   define BSC_KERNELS_X86
+#   define BSC_TARGET(features) __attribute__(( target( features ), optimize( "fp-contract=off" ) ))
+#   include <immintrin.h>
+#elif defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+#   define BSC_KERNELS_X86
+#   define BSC_TARGET(features)
+#   include <immintrin.h>
+#   include <intrin.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+typedef void (*Kernel)( const int count, double a, const double *src, double *dst );
+
+typedef void (*KernelRows)( const int count, const int rows, const double *a,
+                            const double *src, const int stride, double *dst );
+
+struct KernelInfo
+{
+    Kernel kernel;          ///< single row elimination kernel
+    KernelRows kernel_rows; ///< multiple rows elimination kernel
+    const char *name;       ///< kernel name
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void eliminateRowGeneric( const int count, double a, const double *src, double *dst )
+{
+    for ( int c = 0; c < count; c++ )
+    {
+        dst[ c ] -= a * src[ c ];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Subtracts rows src + j * stride multiplied by a[j] from dst, j in [0, rows).
+ * Rows are subtracted from every element one after another, the same as
+ * by calling single row kernel for every row, but dst is loaded and stored once.
+ */
+static void eliminateRowsGeneric( const int count, const int rows, const double *a,
+                                  const double *src, const int stride, double *dst )
+{
+    for ( int c = 0; c < count; c++ )
+    {
+        double d = dst[ c ];
+
+        for ( int j = 0; j < rows; j++ )
+        {
+            d -= a[ j ] * src[ j * stride + c ];
+        }
+
+        dst[ c ] = d;
+    }
+}
+
+#ifdef BSC_KERNELS_X86
+
+////////////////////////////////////////////////////////////////////////////////
+
+// multiplication and subtraction are NOT fused (AVX-512 implies FMA, so contraction
+// is explicitly disabled), so results are exactly the same as from the generic kernel
+
+BSC_TARGET( "avx2" )
+static void eliminateRowAVX2( const int count, double a, const double *src, double *dst )
+{
+    __m256d va = _mm256_set1_pd( a );
+
+    int c = 0;
+
+    for ( ; c + 4 <= count; c += 4 )
+    {
+        __m256d vd = _mm256_loadu_pd( dst + c );
+        __m256d vp = _mm256_mul_pd( va, _mm256_loadu_pd( src + c ) );
+        _mm256_storeu_pd( dst + c, _mm256_sub_pd( vd, vp ) );
+    }
+
+    for ( ; c < count; c++ )
+    {
+        dst[ c ] -= a * src[ c ];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BSC_TARGET( "avx512f" )
+static void eliminateRowAVX512( const int count, double a, const double *src, double *dst )
+{
+    __m512d va = _mm512_set1_pd( a );
+
+    int c = 0;
+
+    for ( ; c + 8 <= count; c += 8 )
+    {
+        __m512d vd = _mm512_loadu_pd( dst + c );
+        __m512d vp = _mm512_mul_pd( va, _mm512_loadu_pd( src + c ) );
+        _mm512_storeu_pd( dst + c, _mm512_sub_pd( vd, vp ) );
+    }
+
+    if ( c < count )
+    {
+        // masked tail instead of scalar loop
+        __mmask8 mask = (__mmask8)( ( 1u << ( count - c ) ) - 1u );
+
+        __m512d vd = _mm512_maskz_loadu_pd( mask, dst + c );
+        __m512d vp = _mm512_mul_pd( va, _mm512_maskz_loadu_pd( mask, src + c ) );
+        _mm512_mask_storeu_pd( dst + c, mask, _mm512_sub_pd( vd, vp ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BSC_TARGET( "avx2" )
+static void eliminateRowsAVX2( const int count, const int rows, const double *a,
+                               const double *src, const int stride, double *dst )
+{
+    int c = 0;
+
+    for ( ; c + 4 <= count; c += 4 )
+    {
+        __m256d vd = _mm256_loadu_pd( dst + c );
+
+        for ( int j = 0; j < rows; j++ )
+        {
+            __m256d vp = _mm256_mul_pd( _mm256_set1_pd( a[ j ] ), _mm256_loadu_pd( src + j * stride + c ) );
+            vd = _mm256_sub_pd( vd, vp );
+        }
+
+        _mm256_storeu_pd( dst + c, vd );
+    }
+
+    if ( c < count )
+    {
+        eliminateRowsGeneric( count - c, rows, a, src + c, stride, dst + c );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BSC_TARGET( "avx512f" )
+static void eliminateRowsAVX512( const int count, const int rows, const double *a,
+                                 const double *src, const int stride, double *dst )
+{
+    int c = 0;
+
+    for ( ; c + 8 <= count; c += 8 )
+    {
+        __m512d vd = _mm512_loadu_pd( dst + c );
+
+        for ( int j = 0; j < rows; j++ )
+        {
+            __m512d vp = _mm512_mul_pd( _mm512_set1_pd( a[ j ] ), _mm512_loadu_pd( src + j * stride + c ) );
+            vd = _mm512_sub_pd( vd, vp );
+        }
+
+        _mm512_storeu_pd( dst + c, vd );
+    }
+
+    if ( c < count )
+    {
+        eliminateRowsGeneric( count - c, rows, a, src + c, stride, dst + c );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool cpuSupports( bool avx512 )
+{
+#   if defined(__GNUC__)
+    __builtin_cpu_init();
+    return avx512 ? __builtin_cpu_supports( "avx512f" ) : __builtin_cpu_supports( "avx2" );
+#   else
+    int info[ 4 ];
+
+    __cpuid( info, 0 );
+    if ( info[ 0 ] < 7 ) return false;
+
+    // OS has to save AVX (and AVX-512) registers on context switch
+    __cpuid( info, 1 );
+    bool osxsave = ( info[ 2 ] & ( 1 << 27 ) ) != 0;
+    bool avx     = ( info[ 2 ] & ( 1 << 28 ) ) != 0;
+    if ( !osxsave || !avx ) return false;
+
+    unsigned long long xcr0 = _xgetbv( 0 );
+
+    __cpuidex( info, 7, 0 );
+
+    if ( avx512 )
+    {
+        return ( xcr0 & 0xe6 ) == 0xe6 && ( info[ 1 ] & ( 1 << 16 ) ) != 0;
+    }
+
+    return ( xcr0 & 0x6 ) == 0x6 && ( info[ 1 ] & ( 1 << 5 ) ) != 0;
+#   endif
+}
+
+#endif // BSC_KERNELS_X86
+
+////////////////////////////////////////////////////////////////////////////////
+
+static KernelInfo selectKernel()
+{
+#   ifdef BSC_KERNELS_X86
+    if ( cpuSupports( true  ) ) return { eliminateRowAVX512, eliminateRowsAVX512, "avx512" };
+    if ( cpuSupports( false ) ) return { eliminateRowAVX2,   eliminateRowsAVX2,   "avx2"   };
+#   endif
+
+    return { eliminateRowGeneric, eliminateRowsGeneric, "generic" };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static const KernelInfo& getKernel()
+{
+    static const KernelInfo info = selectKernel();
+    return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Short rows (small systems or last columns) are eliminated inline,
+ * as calling vectorized kernel costs more than it saves.
+ */
+static inline void eliminate( Kernel kernel, const int count, double a, const double *src, double *dst )
+{
+    if ( count < 8 )
+    {
+        for ( int c = 0; c < count; c++ ) dst[ c ] -= a * src[ c ];
+    }
+    else
+    {
+        kernel( count, a, src, dst );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// blocked LU factorization parameters
+static const int blockSize      = 64;     ///< number of columns in panel
+static const int blockMinSize   = 192;    ///< minimum system size factorized by blocks
+static const int tileColumns    = 64;     ///< number of trailing submatrix tile columns
+static const int threadsMinRows = 128;    ///< minimum number of trailing rows updated by threads
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Factorizes columns [k_begin, k_end) of matrix. Rows are swapped as a whole,
+ * but only columns left of k_end are updated.
+ */
+static int factorizePanel( const int size, double *lu, int *piv,
+                           int k_begin, int k_end, double eps, Kernel kernel )
+{
+    for ( int k = k_begin; k < k_end; k++ )
+    {
+        // looking for the greatest value in the current column (partial pivoting)
+        int p = k;
+
+        for ( int i = k + 1; i < size; i++ )
+        {
+            if ( fabs( lu[ i * size + k ] ) > fabs( lu[ p * size + k ] ) ) p = i;
+        }
+
+        piv[ k ] = p;
+
+        if ( fabs( lu[ p * size + k ] ) < fabs( eps ) )
+        {
+            return BSC_FAILURE;
+        }
+
+        if ( p != k ) GaussJordan::swapRowsMatr( size, lu, k, p );
+
+        double a_kk_inv = 1.0 / lu[ k * size + k ];
+
+        // computing L column and updating panel
+        for ( int i = k + 1; i < size; i++ )
+        {
+            double l_ik = ( lu[ i * size + k ] *= a_kk_inv );
+
+            eliminate( kernel, k_end - k - 1, l_ik, lu + k * size + k + 1, lu + i * size + k + 1 );
+        }
+    }
+
+    return BSC_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Copies U block right of panel [k_begin, k_end) into tiles of tileColumns
+ * columns, every tile stored contiguously. Rows of packed tile are NOT
+ * separated by matrix size, which for some sizes (e.g. 1023) would map them
+ * into the same cache sets.
+ */
+static void packPanelRows( const int size, const double *lu, int k_begin, int k_end, double *packed )
+{
+    int rows = k_end - k_begin;
+
+    for ( int c = k_end; c < size; c += tileColumns )
+    {
+        int count = std::min( tileColumns, size - c );
+
+        for ( int j = 0; j < rows; j++ )
+        {
+            std::copy( lu + ( k_begin + j ) * size + c, lu + ( k_begin + j ) * size + c + count,
+                       packed + j * count );
+        }
+
+        packed += rows * count;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Updates rows [i_begin, i_end) of trailing submatrix (columns right of k_end)
+ * with panel [k_begin, k_end) factors. Tile of packed panel rows stays in cache
+ * while it is subtracted from all rows.
+ */
+static void updateTrailing( const int size, double *lu, int k_begin, int k_end,
+                            int i_begin, int i_end, const double *packed, KernelRows kernel_rows )
+{
+    int rows = k_end - k_begin;
+
+    for ( int c = k_end; c < size; c += tileColumns )
+    {
+        int count = std::min( tileColumns, size - c );
+
+        for ( int i = i_begin; i < i_end; i++ )
+        {
+            double *row = lu + i * size;
+
+            kernel_rows( count, rows, row + k_begin, packed, count, row + c );
+        }
+
+        packed += rows * count;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void GaussJordan::Workspace::reserve( int size )
+{
+    if ( size < 0 ) size = 0;
+
+    if ( (int)_rhs.size() < size )
+    {
+        _mtr.resize( size * size );
+        _rhs.resize( size );
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 int GaussJordan::solve( const int size, const double *mtr, const double *rhs,
                         double *x, double eps )
 {
-    int result = BSC_SUCCESS;
+    Workspace workspace( size );
+
+    return solve( size, mtr, rhs, x, workspace, eps );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int GaussJordan::solve( const int size, const double *mtr, const double *rhs,
+                        double *x, Workspace &workspace, double eps )
+{
+    workspace.reserve( size );
 
-    double *mtr_temp = new double [ size * size ] ;
-    double *rhs_temp = new double [ size ];
+    double *mtr_temp = workspace._mtr.data();
+    double *rhs_temp = workspace._rhs.data();
 
     for ( int i = 0; i < size * size; i++ )
     {
@@ -39,20 +407,27 @@ int GaussJordan::solve( const int size, const double *mtr, const double *rhs,
         if ( i < size ) rhs_temp[ i ] = rhs[ i ];
     }
 
+    const Kernel kernel = getKernel().kernel;
+
     for ( int r = 0; r < size; r++ )
     {
-        // run along diagonal, swapping rows to move zeros (outside the diagonal) downwards
-        if ( fabs( mtr_temp[ r * size + r ] ) < fabs( eps ) )
+        // looking for the greatest value in the current column (partial pivoting)
+        int p = r;
+
+        for ( int i = r + 1; i < size; i++ )
         {
-            if ( r < size - 1 )
-            {
-                swapRowsMatr( size, mtr_temp, r, r+1 );
-                swapRowsVect( size, rhs_temp, r, r+1 );
-            }
-            else
-            {
-                result = BSC_FAILURE;
-            }
+            if ( fabs( mtr_temp[ i * size + r ] ) > fabs( mtr_temp[ p * size + r ] ) ) p = i;
+        }
+
+        if ( fabs( mtr_temp[ p * size + r ] ) < fabs( eps ) )
+        {
+            return BSC_FAILURE;
+        }
+
+        if ( p != r )
+        {
+            swapRowsMatr( size, mtr_temp, r, p );
+            swapRowsVect( size, rhs_temp, r, p );
         }
 
         // value on diagonal A(r,r)
@@ -60,7 +435,8 @@ int GaussJordan::solve( const int size, const double *mtr, const double *rhs,
         double a_rr_inv = 1.0 / a_rr;
 
         // deviding current row by value on diagonal
-        for ( int c = 0; c < size; c++ )
+        // columns left of the diagonal are already zero
+        for ( int c = r; c < size; c++ )
         {
             mtr_temp[ r * size + c ] *= a_rr_inv;
         }
@@ -71,16 +447,16 @@ int GaussJordan::solve( const int size, const double *mtr, const double *rhs,
         // for every row current row is multiplied by A(i,r)
         // where r stands for row that is substracted from other rows
         // and i stands for row that is substracting from
+        // only columns right of the diagonal are updated, column r is not used anymore
+        const double *row_r = mtr_temp + r * size + r + 1;
+
         for ( int i = 0; i < size; i++ )
         {
             if ( i != r )
             {
                 double a_ir = mtr_temp[ i * size + r ];
 
-                for ( int c = 0; c < size; c++ )
-                {
-                    mtr_temp[ i * size + c ] -= a_ir * mtr_temp[ r * size + c ];
-                }
+                eliminate( kernel, size - r - 1, a_ir, row_r, mtr_temp + i * size + r + 1 );
 
                 rhs_temp[ i ] -= a_ir * rhs_temp[ r ];
             }
@@ -93,10 +469,175 @@ int GaussJordan::solve( const int size, const double *mtr, const double *rhs,
         x[ i ] = rhs_temp[ i ];
     }
 
-    delete [] mtr_temp;
-    delete [] rhs_temp;
+    return BSC_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int GaussJordan::factorize( const int size, double *lu, int *piv, double eps, ThreadPool *pool )
+{
+    const Kernel     kernel      = getKernel().kernel;
+    const KernelRows kernel_rows = getKernel().kernel_rows;
+
+    if ( size < blockMinSize )
+    {
+        return factorizePanel( size, lu, piv, 0, size, eps, kernel );
+    }
+
+    // U block right of the current panel packed into tiles
+    std::vector< double > packed( blockSize * ( size - 1 ) );
+
+    for ( int k_begin = 0; k_begin < size; k_begin += blockSize )
+    {
+        int k_end = std::min( k_begin + blockSize, size );
+
+        if ( factorizePanel( size, lu, piv, k_begin, k_end, eps, kernel ) != BSC_SUCCESS )
+        {
+            return BSC_FAILURE;
+        }
+
+        if ( k_end == size ) break;
+
+        // computing U block right of the panel
+        for ( int k = k_begin; k < k_end; k++ )
+        {
+            for ( int i = k + 1; i < k_end; i++ )
+            {
+                eliminate( kernel, size - k_end, lu[ i * size + k ],
+                           lu + k * size + k_end, lu + i * size + k_end );
+            }
+        }
 
-    return result;
+        packPanelRows( size, lu, k_begin, k_end, packed.data() );
+
+        // updating trailing submatrix, every row is updated by exactly one thread
+        int rows = size - k_end;
+        const double *u = packed.data();
+
+        if ( pool && pool->getWorkers() > 1 && rows >= threadsMinRows )
+        {
+            pool->run( rows, [ = ]( int begin, int end )
+            {
+                updateTrailing( size, lu, k_begin, k_end, k_end + begin, k_end + end, u, kernel_rows );
+            });
+        }
+        else
+        {
+            updateTrailing( size, lu, k_begin, k_end, k_end, size, u, kernel_rows );
+        }
+    }
+
+    return BSC_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void GaussJordan::substitute( const int size, const double *lu, const int *piv,
+                              const int count, const double *rhs, double *x )
+{
+    for ( int v = 0; v < count; v++ )
+    {
+        const double *b = rhs + v * size;
+        double *y = x + v * size;
+
+        if ( y != b )
+        {
+            for ( int i = 0; i < size; i++ ) y[ i ] = b[ i ];
+        }
+
+        // applying rows permutation
+        for ( int k = 0; k < size; k++ )
+        {
+            if ( piv[ k ] != k ) swapRowsVect( size, y, k, piv[ k ] );
+        }
+
+        // forward substitution (L has unit diagonal)
+        for ( int i = 1; i < size; i++ )
+        {
+            double sum = y[ i ];
+
+            for ( int j = 0; j < i; j++ )
+            {
+                sum -= lu[ i * size + j ] * y[ j ];
+            }
+
+            y[ i ] = sum;
+        }
+
+        // back substitution
+        for ( int i = size - 1; i >= 0; i-- )
+        {
+            double sum = y[ i ];
+
+            for ( int j = i + 1; j < size; j++ )
+            {
+                sum -= lu[ i * size + j ] * y[ j ];
+            }
+
+            y[ i ] = sum / lu[ i * size + i ];
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool GaussJordan::hasFixedSize( const int size )
+{
+    switch ( size )
+    {
+        case 4: case 7: case 8: case 15: case 16: case 31:
+            return true;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int GaussJordan::factorizeFixed( const int size, double *lu, int *piv, double eps )
+{
+    switch ( size )
+    {
+        case  4: return factorize<  4 >( lu, piv, eps );
+        case  7: return factorize<  7 >( lu, piv, eps );
+        case  8: return factorize<  8 >( lu, piv, eps );
+        case 15: return factorize< 15 >( lu, piv, eps );
+        case 16: return factorize< 16 >( lu, piv, eps );
+        case 31: return factorize< 31 >( lu, piv, eps );
+    }
+
+    return BSC_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void GaussJordan::substituteFixed( const int size, const double *lu, const int *piv,
+                                   const int count, const double *rhs, double *x )
+{
+    switch ( size )
+    {
+        case  4: substitute<  4 >( lu, piv, count, rhs, x ); break;
+        case  7: substitute<  7 >( lu, piv, count, rhs, x ); break;
+        case  8: substitute<  8 >( lu, piv, count, rhs, x ); break;
+        case 15: substitute< 15 >( lu, piv, count, rhs, x ); break;
+        case 16: substitute< 16 >( lu, piv, count, rhs, x ); break;
+        case 31: substitute< 31 >( lu, piv, count, rhs, x ); break;
+        default: substitute( size, lu, piv, count, rhs, x ); break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void GaussJordan::eliminateRow( const int count, double a, const double *src, double *dst )
+{
+    getKernel().kernel( count, a, src, dst );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char* GaussJordan::getKernelName()
+{
+    return getKernel().name;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -105,16 +646,12 @@ void GaussJordan::swapRowsMatr( const int size, double *mtr, int row1, int row2
 {
     if ( ( row1 < size ) && ( row2 < size ) )
     {
-        double *temp = new double[ size ];
-
         for ( int c = 0; c < size; c++ )
         {
-            temp[ c ] = mtr[ row1 * size + c ];
+            double temp = mtr[ row1 * size + c ];
             mtr[ row1 * size + c ] = mtr[ row2 * size + c ];
-            mtr[ row2 * size + c ] = temp[ c ];
+            mtr[ row2 * size + c ] = temp;
         }
-
-        delete [] temp;
     }
 }
 
@@ -25,11 +25,16 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <cmath>
+#include <vector>
 
 #include <defs.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
+class ThreadPool;
+
+////////////////////////////////////////////////////////////////////////////////
+
 /**
  * @brief Gauss-Jordan numerical method of solving systems of linear equations.
  *
@@ -42,16 +47,177 @@ class GaussJordan
 public:
 
     /**
-     * @brief Solves system of linear equations using Gauss-Jordan method.
+     * @brief Solver workspace owned by the caller.
+     *
+     * Buffers grow only when larger system than ever before is solved,
+     * so repeated solves with the same workspace (e.g. in sweeps) perform
+     * no heap allocations. Workspace must not be shared between threads.
+     */
+    class Workspace
+    {
+        friend class GaussJordan;
+
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param size system size the buffers are allocated for
+         */
+        explicit Workspace( int size = 0 ) { reserve( size ); }
+
+        /**
+         * @brief Allocates buffers for given system size (if not allocated yet).
+         * @param size system size
+         */
+        void reserve( int size );
+
+    private:
+
+        std::vector< double > _mtr;     ///< left hand side matrix copy
+        std::vector< double > _rhs;     ///< right hand side vector copy
+    };
+
+    /**
+     * @brief Solves system of linear equations using Gauss-Jordan method
+     * with partial pivoting. Temporary workspace is allocated on every call.
      * @param mtr left hand side matrix
      * @param rhs right hand size vector
      * @param x result vector
      * @param eps minimum value treated as not-zero
-     * @return FDM_SUCCESS on success and FDM_FAILURE on failure
+     * @return BSC_SUCCESS on success and BSC_FAILURE on failure
      */
     static int solve( const int size, const double *mtr, const double *rhs,
                       double *x, double eps = 1.0e-14 );
 
+    /**
+     * @brief Solves system of linear equations using Gauss-Jordan method
+     * with partial pivoting (row with the greatest absolute value in the
+     * current column is used as pivot row). No heap allocations are done
+     * if workspace has been already allocated for given size.
+     * @param mtr left hand side matrix
+     * @param rhs right hand size vector
+     * @param x result vector (NOT changed on failure)
+     * @param workspace solver workspace
+     * @param eps minimum value treated as not-zero
+     * @return BSC_SUCCESS on success and BSC_FAILURE on failure (singular matrix)
+     */
+    static int solve( const int size, const double *mtr, const double *rhs,
+                      double *x, Workspace &workspace, double eps = 1.0e-14 );
+
+    /**
+     * @brief Factorizes matrix in place into LU form using partial pivoting.
+     * Factorization is done once and then can be reused by substitute()
+     * for any number of right hand side vectors.
+     * Large matrices are factorized by blocks of columns (right-looking
+     * blocked LU): panel of columns is factorized and then trailing
+     * submatrix is updated tile by tile, so data are reused from cache.
+     * Every element is updated in the same order as in unblocked
+     * factorization, so results do not depend on blocking nor on threads.
+     * @param size system size
+     * @param lu on input left hand side matrix, on output L and U factors
+     * @param piv result pivots, row k has been swapped with row piv[k]
+     * @param eps minimum value treated as not-zero
+     * @param pool thread pool used to update trailing submatrix tiles (optional)
+     * @return BSC_SUCCESS on success and BSC_FAILURE on failure
+     */
+    static int factorize( const int size, double *lu, int *piv,
+                          double eps = 1.0e-14, ThreadPool *pool = 0 );
+
+    /**
+     * @brief Solves factorized system of linear equations for a block of
+     * right hand side vectors.
+     * @param size system size
+     * @param lu L and U factors computed by factorize()
+     * @param piv pivots computed by factorize()
+     * @param count number of right hand side vectors
+     * @param rhs right hand side vectors stored one after another
+     * @param x result vectors stored one after another (may be the same as rhs)
+     */
+    static void substitute( const int size, const double *lu, const int *piv,
+                            const int count, const double *rhs, double *x );
+
+    /**
+     * @brief Factorizes matrix of compile-time size N in place into LU form
+     * using partial pivoting. Loops have constant bounds, so small systems
+     * are fully unrolled by compiler. Results are exactly the same as from
+     * factorize( N, lu, piv, eps ).
+     * @param lu on input left hand side matrix, on output L and U factors
+     * @param piv result pivots, row k has been swapped with row piv[k]
+     * @param eps minimum value treated as not-zero
+     * @return BSC_SUCCESS on success and BSC_FAILURE on failure
+     */
+    template< int N >
+    static int factorize( double *lu, int *piv, double eps = 1.0e-14 );
+
+    /**
+     * @brief Solves factorized system of linear equations of compile-time
+     * size N for a block of right hand side vectors. Vectors are solved
+     * by four in stack allocated array (see substituteBlock()). Results are exactly the same as from
+     * substitute( N, lu, piv, count, rhs, x ).
+     * @param lu L and U factors computed by factorize()
+     * @param piv pivots computed by factorize()
+     * @param count number of right hand side vectors
+     * @param rhs right hand side vectors stored one after another
+     * @param x result vectors stored one after another (may be the same as rhs)
+     */
+    template< int N >
+    static void substitute( const double *lu, const int *piv,
+                            const int count, const double *rhs, double *x );
+
+    /**
+     * @brief Solves factorized system of linear equations of compile-time
+     * size N for block of V right hand side vectors, interleaved in stack
+     * allocated array. Operations on every vector are done in the same order
+     * as by substitute().
+     */
+    template< int N, int V >
+    static void substituteBlock( const double *lu, const int *piv,
+                                 const double *rhs, double *x );
+
+    /**
+     * @brief Checks if there is compile-time size specialization used by
+     * factorizeFixed() and substituteFixed() for given system size.
+     * Specializations exist for the most common systems sizes: 4, 7, 8,
+     * 15, 16 and 31 unknowns (Fourier series accuracies of 4, 8 and 16
+     * terms, in symmetric and non-symmetric mode).
+     * @param size system size
+     * @return true if there is specialization for given size
+     */
+    static bool hasFixedSize( const int size );
+
+    /**
+     * @brief Factorizes matrix using compile-time size specialization.
+     * @see hasFixedSize()
+     * @return BSC_SUCCESS on success and BSC_FAILURE on failure (also if
+     * there is no specialization for given size)
+     */
+    static int factorizeFixed( const int size, double *lu, int *piv,
+                               double eps = 1.0e-14 );
+
+    /**
+     * @brief Solves factorized system of linear equations using compile-time
+     * size specialization. Falls back to substitute() if there is no
+     * specialization for given size.
+     * @see hasFixedSize()
+     */
+    static void substituteFixed( const int size, const double *lu, const int *piv,
+                                 const int count, const double *rhs, double *x );
+
+    /**
+     * @brief Subtracts row multiplied by factor from another row.
+     * Vectorized kernel (AVX-512 or AVX2) is selected at runtime according
+     * to the CPU features, with portable fallback. Kernels do not use fused
+     * multiply-add, so results do not depend on the selected kernel.
+     * @param count number of elements
+     * @param a factor
+     * @param src row to be subtracted
+     * @param dst row to be subtracted from, dst[c] -= a * src[c]
+     */
+    static void eliminateRow( const int count, double a, const double *src, double *dst );
+
+    /** @return name of the row elimination kernel selected for the CPU ("avx512", "avx2" or "generic") */
+    static const char* getKernelName();
+
     /** @brief Swaps matrix rows. */
     static void swapRowsMatr( const int size, double *mtr, int row1, int row2 );
 
@@ -61,4 +227,128 @@ public:
 
 ////////////////////////////////////////////////////////////////////////////////
 
+template< int N >
+int GaussJordan::factorize( double *lu, int *piv, double eps )
+{
+    for ( int k = 0; k < N; k++ )
+    {
+        // looking for the greatest value in the current column (partial pivoting)
+        int p = k;
+
+        for ( int i = k + 1; i < N; i++ )
+        {
+            if ( fabs( lu[ i * N + k ] ) > fabs( lu[ p * N + k ] ) ) p = i;
+        }
+
+        piv[ k ] = p;
+
+        if ( fabs( lu[ p * N + k ] ) < fabs( eps ) )
+        {
+            return BSC_FAILURE;
+        }
+
+        if ( p != k )
+        {
+            for ( int c = 0; c < N; c++ )
+            {
+                double temp = lu[ k * N + c ];
+                lu[ k * N + c ] = lu[ p * N + c ];
+                lu[ p * N + c ] = temp;
+            }
+        }
+
+        double a_kk_inv = 1.0 / lu[ k * N + k ];
+
+        // computing L column and updating trailing submatrix
+        for ( int i = k + 1; i < N; i++ )
+        {
+            double l_ik = ( lu[ i * N + k ] *= a_kk_inv );
+
+            for ( int c = k + 1; c < N; c++ )
+            {
+                lu[ i * N + c ] -= l_ik * lu[ k * N + c ];
+            }
+        }
+    }
+
+    return BSC_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template< int N, int V >
+void GaussJordan::substituteBlock( const double *lu, const int *piv,
+                                   const double *rhs, double *x )
+{
+    // vectors are interleaved, so independent operations on different
+    // vectors are next to each other and can be vectorized by compiler
+    double y[ N ][ V ];
+
+    for ( int i = 0; i < N; i++ )
+    {
+        for ( int w = 0; w < V; w++ ) y[ i ][ w ] = rhs[ w * N + i ];
+    }
+
+    // applying rows permutation
+    for ( int k = 0; k < N; k++ )
+    {
+        for ( int w = 0; w < V; w++ )
+        {
+            double temp = y[ k ][ w ];
+            y[ k ][ w ] = y[ piv[ k ] ][ w ];
+            y[ piv[ k ] ][ w ] = temp;
+        }
+    }
+
+    // forward substitution (L has unit diagonal)
+    for ( int i = 1; i < N; i++ )
+    {
+        for ( int j = 0; j < i; j++ )
+        {
+            double l_ij = lu[ i * N + j ];
+
+            for ( int w = 0; w < V; w++ ) y[ i ][ w ] -= l_ij * y[ j ][ w ];
+        }
+    }
+
+    // back substitution
+    for ( int i = N - 1; i >= 0; i-- )
+    {
+        for ( int j = i + 1; j < N; j++ )
+        {
+            double u_ij = lu[ i * N + j ];
+
+            for ( int w = 0; w < V; w++ ) y[ i ][ w ] -= u_ij * y[ j ][ w ];
+        }
+
+        for ( int w = 0; w < V; w++ ) y[ i ][ w ] /= lu[ i * N + i ];
+    }
+
+    for ( int i = 0; i < N; i++ )
+    {
+        for ( int w = 0; w < V; w++ ) x[ w * N + i ] = y[ i ][ w ];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template< int N >
+void GaussJordan::substitute( const double *lu, const int *piv,
+                              const int count, const double *rhs, double *x )
+{
+    int v = 0;
+
+    for ( ; v + 4 <= count; v += 4 )
+    {
+        substituteBlock< N, 4 >( lu, piv, rhs + v * N, x + v * N );
+    }
+
+    for ( ; v < count; v++ )
+    {
+        substituteBlock< N, 1 >( lu, piv, rhs + v * N, x + v * N );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 #endif // GAUSSJORDAN_H
@@ -0,0 +1,152 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <MappedFile.h>
+
+#include <fstream>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef _WIN32
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+MappedFile::MappedFile() :
+    _data   ( 0 ),
+    _buffer ( 0 ),
+    _size   ( 0 ),
+    _open   ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+bool MappedFile::open( const char *file )
+{
+    close();
+
+    // reading whole file into aligned buffer
+    std::fstream fs( file, std::ios_base::in | std::ios_base::binary );
+
+    if ( !fs.is_open() ) return false;
+
+    fs.seekg( 0, std::ios_base::end );
+    size_t size = (size_t)fs.tellg();
+    fs.seekg( 0, std::ios_base::beg );
+
+    _buffer = new char [ size + alignment ];
+    _data = _buffer + ( alignment - ( (uintptr_t)_buffer % alignment ) ) % alignment;
+
+    fs.read( _data, size );
+
+    if ( (size_t)fs.gcount() != size )
+    {
+        close();
+        return false;
+    }
+
+    _size = size;
+    _open = true;
+
+    return true;
+}
+#else
+bool MappedFile::open( const char *file )
+{
+    close();
+
+    int fd = ::open( file, O_RDONLY );
+
+    if ( fd < 0 ) return false;
+
+    struct stat st;
+
+    if ( fstat( fd, &st ) != 0 )
+    {
+        ::close( fd );
+        return false;
+    }
+
+    // empty file cannot be mapped
+    if ( st.st_size > 0 )
+    {
+        void *data = mmap( 0, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+
+        if ( data == MAP_FAILED )
+        {
+            ::close( fd );
+            return false;
+        }
+
+        _data = (char*)data;
+        _size = (size_t)st.st_size;
+    }
+
+    // file descriptor is no longer needed after mapping
+    ::close( fd );
+
+    _open = true;
+
+    return true;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MappedFile::close()
+{
+#   ifdef _WIN32
+    delete [] _buffer;
+    _buffer = 0;
+#   else
+    if ( _data ) munmap( _data, _size );
+#   endif
+
+    _data = 0;
+    _size = 0;
+    _open = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool MappedFile::replace( const char *from, const char *to )
+{
+#   ifdef _WIN32
+    // rename() does not replace existing file on Windows
+    // (files are read into buffers there, so nothing is mapped)
+    remove( to );
+#   endif
+
+    return rename( from, to ) == 0;
+}
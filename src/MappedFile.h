@@ -0,0 +1,93 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Read-only file mapped into memory.
+ *
+ * File is mapped privately (copy-on-write), so mapped data can be modified
+ * without affecting the file. Pages are read from disk only when accessed.
+ * If memory mapping is not available whole file is read into a buffer
+ * aligned to MappedFile::alignment.
+ */
+class MappedFile
+{
+public:
+
+    static const size_t alignment = 64; ///< [bytes] minimum data alignment
+
+    /** @brief Constructor. */
+    MappedFile();
+
+    /** @brief Destructor. Unmaps file. */
+    ~MappedFile();
+
+    /**
+     * @brief Maps file into memory, previous file is unmapped.
+     * @param file file path
+     * @return true on success and false on failure
+     */
+    bool open( const char *file );
+
+    /** @brief Unmaps file. */
+    void close();
+
+    /** @return true if file is mapped */
+    bool isOpen() const { return _open; }
+
+    /** @return mapped file data, null address if file is empty */
+    char* getData() const { return _data; }
+
+    /** @return [bytes] mapped file size */
+    size_t getSize() const { return _size; }
+
+    /**
+     * @brief Replaces file with another one, e.g. with just written temporary
+     * file. Replaced file is not truncated, so its data which is currently
+     * mapped stays valid until it is unmapped.
+     * @param from new file path (file is moved)
+     * @param to replaced file path
+     * @return true on success and false on failure
+     */
+    static bool replace( const char *from, const char *to );
+
+private:
+
+    char  *_data;               ///< mapped file address
+    char  *_buffer;             ///< file buffer (if memory mapping is not available)
+    size_t _size;               ///< [bytes] mapped file size
+    bool   _open;               ///< specifies if file is mapped
+
+    MappedFile( const MappedFile & );
+    MappedFile& operator=( const MappedFile & );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // MAPPEDFILE_H
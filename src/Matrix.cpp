@@ -0,0 +1,136 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <Matrix.h>
+
+#include <cmath>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Matrix::multiplyTransposed( const int rows_a, const int rows_b, const int cols,
+                                 const double *a, const double *b, double *c )
+{
+    for ( int i = 0; i < rows_a * rows_b; i++ )
+    {
+        c[ i ] = 0.0;
+    }
+
+    // tiles of A rows, B rows and inner dimension are small enough to stay in cache
+    for ( int k0 = 0; k0 < cols; k0 += blockCols )
+    {
+        int k1 = ( k0 + blockCols < cols ) ? k0 + blockCols : cols;
+
+        for ( int i0 = 0; i0 < rows_a; i0 += blockRows )
+        {
+            int i1 = ( i0 + blockRows < rows_a ) ? i0 + blockRows : rows_a;
+
+            for ( int j0 = 0; j0 < rows_b; j0 += blockRows )
+            {
+                int j1 = ( j0 + blockRows < rows_b ) ? j0 + blockRows : rows_b;
+
+                for ( int i = i0; i < i1; i++ )
+                {
+                    const double *a_i = a + i * cols;
+                    double *c_i = c + i * rows_b;
+
+                    for ( int j = j0; j < j1; j++ )
+                    {
+                        const double *b_j = b + j * cols;
+                        double sum = 0.0;
+
+                        for ( int k = k0; k < k1; k++ )
+                        {
+                            sum += a_i[ k ] * b_j[ k ];
+                        }
+
+                        c_i[ j ] += sum;
+                    }
+                }
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Matrix::reduceHouseholder( const int rows, const int cols, const int cols_total, double *a )
+{
+    std::vector< double > dots( cols_total );
+
+    for ( int k = 0; k < cols; k++ )
+    {
+        double norm = 0.0;
+
+        for ( int i = k; i < rows; i++ )
+        {
+            norm += a[ i * cols_total + k ] * a[ i * cols_total + k ];
+        }
+
+        norm = sqrt( norm );
+
+        // column is already zero below diagonal
+        if ( norm == 0.0 ) continue;
+
+        // reflection v = x - alpha * e_k, sign of alpha avoids cancellation,
+        // tau = 2 / |v|^2 = 1 / ( norm^2 - alpha * x_k )
+        double a_kk  = a[ k * cols_total + k ];
+        double alpha = ( a_kk > 0.0 ) ? -norm : norm;
+        double tau   = 1.0 / ( norm * norm - alpha * a_kk );
+
+        // Householder vector is stored in place of column k
+        a[ k * cols_total + k ] = a_kk - alpha;
+
+        for ( int j = k + 1; j < cols_total; j++ )
+        {
+            dots[ j ] = 0.0;
+        }
+
+        // v^T * A for remaining columns, computed along rows
+        for ( int i = k; i < rows; i++ )
+        {
+            const double *a_i = a + i * cols_total;
+            double v_i = a_i[ k ];
+
+            for ( int j = k + 1; j < cols_total; j++ )
+            {
+                dots[ j ] += v_i * a_i[ j ];
+            }
+        }
+
+        // A -= tau * v * ( v^T * A )
+        for ( int i = k; i < rows; i++ )
+        {
+            double *a_i = a + i * cols_total;
+            double s_i = tau * a_i[ k ];
+
+            for ( int j = k + 1; j < cols_total; j++ )
+            {
+                a_i[ j ] -= s_i * dots[ j ];
+            }
+
+            a_i[ k ] = 0.0;
+        }
+
+        a[ k * cols_total + k ] = alpha;
+    }
+}
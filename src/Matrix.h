@@ -0,0 +1,71 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef MATRIX_H
+#define MATRIX_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Dense matrix operations on row-major arrays.
+ *
+ * @see Goto K., van de Geijn R.: Anatomy of High-Performance Matrix Multiplication, 2008
+ * @see https://en.wikipedia.org/wiki/QR_decomposition
+ */
+class Matrix
+{
+public:
+
+    static const int blockRows = 32;    ///< rows tile size
+    static const int blockCols = 256;   ///< inner dimension tile size
+
+    /**
+     * @brief Computes matrix product C = A * B^T using cache-blocked algorithm.
+     * Since both A and B are traversed along rows, inner products are computed
+     * on contiguous memory.
+     * @param rows_a number of rows of A (and rows of C)
+     * @param rows_b number of rows of B (and columns of C)
+     * @param cols number of columns of A and B
+     * @param a A matrix (rows_a x cols)
+     * @param b B matrix (rows_b x cols)
+     * @param c result C matrix (rows_a x rows_b)
+     */
+    static void multiplyTransposed( const int rows_a, const int rows_b, const int cols,
+                                    const double *a, const double *b, double *c );
+
+    /**
+     * @brief Reduces matrix in place to upper triangular form with Householder
+     * reflections (QR decomposition, Q is not stored). Reflections are applied
+     * to all columns, so for augmented matrix [ A | B ] of overdetermined system
+     * the first cols rows become [ R | Q^T * B ] and least-squares solution is
+     * obtained by back substitution, without squaring condition number as normal
+     * equations do. Rows are accessed contiguously.
+     * @param rows number of rows (not less than cols)
+     * @param cols number of reduced columns
+     * @param cols_total total number of columns (reduced and only transformed)
+     * @param a matrix (rows x cols_total)
+     */
+    static void reduceHouseholder( const int rows, const int cols, const int cols_total, double *a );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // MATRIX_H
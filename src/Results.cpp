@@ -0,0 +1,186 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <Results.h>
+
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+Results::Results() :
+    _arena ( 0 )
+{
+    release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Results::~Results()
+{
+    release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+size_t Results::getCount( Array array, int aoa_iterations, int fourier_accuracy, int sections_fullspan )
+{
+    switch ( array )
+    {
+    case EquationsRHS:
+    case FourierTerms:
+        return (size_t)aoa_iterations * fourier_accuracy;
+
+    case Gamma:
+    case LiftCoefficientDistribution:
+    case InducedVelocityDistribution:
+    case InducedDragCoefficientDistribution:
+        return (size_t)aoa_iterations * sections_fullspan;
+
+    default:
+        return (size_t)aoa_iterations;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Results::allocate( int aoa_iterations, int fourier_accuracy, int sections_fullspan )
+{
+    release();
+
+    size_t size_rows = align( (size_t)aoa_iterations * sizeof(double*) );
+    size_t size_data[ ArraysCount ];
+
+    size_t size = _rowsCount * size_rows;
+
+    for ( int i = 0; i < ArraysCount; i++ )
+    {
+        size_data[ i ] = align( getCount( (Array)i, aoa_iterations, fourier_accuracy, sections_fullspan ) * sizeof(double) );
+        size += size_data[ i ];
+    }
+
+    char *ptr = allocateArena( size );
+    char *rows = ptr;
+    ptr += _rowsCount * size_rows;
+
+    double *data[ ArraysCount ];
+
+    for ( int i = 0; i < ArraysCount; i++ )
+    {
+        data[ i ] = (double*)ptr;
+        ptr += size_data[ i ];
+    }
+
+    setArrays( aoa_iterations, fourier_accuracy, sections_fullspan, rows, data );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Results::attach( int aoa_iterations, int fourier_accuracy, int sections_fullspan,
+                      double *const data[ ArraysCount ] )
+{
+    release();
+
+    size_t size_rows = align( (size_t)aoa_iterations * sizeof(double*) );
+
+    char *rows = allocateArena( _rowsCount * size_rows );
+
+    setArrays( aoa_iterations, fourier_accuracy, sections_fullspan, rows, data );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Results::release()
+{
+    delete [] _arena;
+    _arena = 0;
+
+    angle_of_attack_deg = 0;
+    angle_of_attack_rad = 0;
+    equations_rhs = 0;
+    fourier_terms = 0;
+    gamma = 0;
+    lift_coefficient_distribution = 0;
+    induced_velocity_distribution = 0;
+    induced_drag_coefficient_distribution = 0;
+    lift_coefficient = 0;
+    induced_drag_coefficient = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+size_t Results::align( size_t size )
+{
+    return ( ( size + alignment - 1 ) / alignment ) * alignment;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+char* Results::allocateArena( size_t size )
+{
+    _arena = new char [ size + alignment ];
+
+    return _arena + ( alignment - ( (uintptr_t)_arena % alignment ) ) % alignment;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Results::setArrays( int aoa_iterations, int fourier_accuracy, int sections_fullspan,
+                         char *rows, double *const data[ ArraysCount ] )
+{
+    size_t size_rows = align( (size_t)aoa_iterations * sizeof(double*) );
+
+    angle_of_attack_deg      = data[ AngleOfAttackDeg ];
+    angle_of_attack_rad      = data[ AngleOfAttackRad ];
+    lift_coefficient         = data[ LiftCoefficient ];
+    induced_drag_coefficient = data[ InducedDragCoefficient ];
+
+    double ***rows_ptr[] = {
+        &equations_rhs,
+        &fourier_terms,
+        &gamma,
+        &lift_coefficient_distribution,
+        &induced_velocity_distribution,
+        &induced_drag_coefficient_distribution
+    };
+
+    Array rows_array[] = {
+        EquationsRHS,
+        FourierTerms,
+        Gamma,
+        LiftCoefficientDistribution,
+        InducedVelocityDistribution,
+        InducedDragCoefficientDistribution
+    };
+
+    for ( int i = 0; i < _rowsCount; i++ )
+    {
+        int cols = ( i < 2 ) ? fourier_accuracy : sections_fullspan;
+
+        *rows_ptr[ i ] = (double**)rows;
+        rows += size_rows;
+
+        for ( int a = 0; a < aoa_iterations; a++ )
+        {
+            (*rows_ptr[ i ])[ a ] = data[ rows_array[ i ] ] + a * cols;
+        }
+    }
+}
@@ -0,0 +1,134 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef RESULTS_H
+#define RESULTS_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Angle of attack dependent computation results.
+ *
+ * All arrays are placed in a single memory block (arena). Every array is
+ * aligned to the cache line size and two-dimensional arrays are stored
+ * row-major with contiguous rows, so array[0] points to the whole array
+ * data and rows can be processed as a single block.
+ *
+ * Alternatively arrays data can be attached from external memory (e.g.
+ * memory-mapped file), in which case only rows pointers are allocated.
+ */
+class Results
+{
+public:
+
+    static const size_t alignment = 64;     ///< [bytes] arrays alignment
+
+    /** Results arrays. */
+    enum Array
+    {
+        AngleOfAttackDeg = 0,               ///< Results::angle_of_attack_deg
+        AngleOfAttackRad,                   ///< Results::angle_of_attack_rad
+        EquationsRHS,                       ///< Results::equations_rhs
+        FourierTerms,                       ///< Results::fourier_terms
+        Gamma,                              ///< Results::gamma
+        LiftCoefficientDistribution,        ///< Results::lift_coefficient_distribution
+        InducedVelocityDistribution,        ///< Results::induced_velocity_distribution
+        InducedDragCoefficientDistribution, ///< Results::induced_drag_coefficient_distribution
+        LiftCoefficient,                    ///< Results::lift_coefficient
+        InducedDragCoefficient,             ///< Results::induced_drag_coefficient
+        ArraysCount                         ///< number of arrays
+    };
+
+    /**
+     * @brief Returns number of array elements.
+     * @param array array
+     * @param aoa_iterations number of angles of attack
+     * @param fourier_accuracy number of Fourier series terms
+     * @param sections_fullspan number of full span sections
+     * @return number of array elements
+     */
+    static size_t getCount( Array array, int aoa_iterations, int fourier_accuracy, int sections_fullspan );
+
+    /** @brief Constructor. */
+    Results();
+
+    /** @brief Destructor. Releases arena. */
+    ~Results();
+
+    /**
+     * @brief Allocates arena for all arrays, previous arena is released.
+     * @param aoa_iterations number of angles of attack
+     * @param fourier_accuracy number of Fourier series terms
+     * @param sections_fullspan number of full span sections
+     */
+    void allocate( int aoa_iterations, int fourier_accuracy, int sections_fullspan );
+
+    /**
+     * @brief Attaches arrays data placed in external memory, previous arena
+     * is released. Data is not copied and must remain valid until release.
+     * @param aoa_iterations number of angles of attack
+     * @param fourier_accuracy number of Fourier series terms
+     * @param sections_fullspan number of full span sections
+     * @param data arrays data indexed with Results::Array
+     */
+    void attach( int aoa_iterations, int fourier_accuracy, int sections_fullspan,
+                 double *const data[ ArraysCount ] );
+
+    /** @brief Releases arena and sets all arrays to null address. */
+    void release();
+
+    double *angle_of_attack_deg;                    ///< [aoa] [deg]
+    double *angle_of_attack_rad;                    ///< [aoa] [rad]
+    double **equations_rhs;                         ///< [aoa][fourier_accuracy]
+    double **fourier_terms;                         ///< [aoa][fourier_accuracy]
+    double **gamma;                                 ///< [aoa][sections_fullspan]
+    double **lift_coefficient_distribution;         ///< [aoa][sections_fullspan]
+    double **induced_velocity_distribution;         ///< [aoa][sections_fullspan]
+    double **induced_drag_coefficient_distribution; ///< [aoa][sections_fullspan]
+    double *lift_coefficient;                       ///< [aoa]
+    double *induced_drag_coefficient;               ///< [aoa]
+
+private:
+
+    char *_arena;                                   ///< arena memory block
+    static const int _rowsCount = 6;                ///< number of two-dimensional arrays
+
+    Results( const Results & );
+    Results& operator=( const Results & );
+
+    /** @brief Returns size rounded up to the alignment. */
+    static size_t align( size_t size );
+
+    /** @brief Allocates arena of given size and returns its aligned address. */
+    char* allocateArena( size_t size );
+
+    /** @brief Sets arrays and rows pointers. */
+    void setArrays( int aoa_iterations, int fourier_accuracy, int sections_fullspan,
+                    char *rows, double *const data[ ArraysCount ] );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // RESULTS_H
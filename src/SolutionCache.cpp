@@ -0,0 +1,163 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <SolutionCache.h>
+
+#include <stdint.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SolutionCache::Key::computeHash()
+{
+    // FNV-1a hash of all key values
+    uint64_t h = 14695981039346656037ULL;
+
+    auto add = [ &h ]( const void *data, size_t size )
+    {
+        const unsigned char *bytes = (const unsigned char*)data;
+
+        for ( size_t i = 0; i < size; i++ )
+        {
+            h ^= bytes[ i ];
+            h *= 1099511628211ULL;
+        }
+    };
+
+    if ( !sections_data.empty() ) add( &sections_data[ 0 ], sections_data.size() * sizeof(double) );
+
+    add( &sections_iterations , sizeof(sections_iterations) );
+    add( &fourier_accuracy    , sizeof(fourier_accuracy) );
+    add( &symmetric           , sizeof(symmetric) );
+    add( &least_squares       , sizeof(least_squares) );
+
+    hash = (size_t)h;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool SolutionCache::Key::operator== ( const Key &key ) const
+{
+    // geometry is compared bitwise, the same as it is hashed
+    return hash == key.hash
+        && sections_iterations == key.sections_iterations
+        && fourier_accuracy    == key.fourier_accuracy
+        && symmetric           == key.symmetric
+        && least_squares       == key.least_squares
+        && sections_data.size() == key.sections_data.size()
+        && ( sections_data.empty()
+          || memcmp( &sections_data[ 0 ], &key.sections_data[ 0 ], sections_data.size() * sizeof(double) ) == 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SolutionCache* SolutionCache::instance()
+{
+    static SolutionCache cache;
+    return &cache;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SolutionCache::SolutionCache() :
+    _capacity ( defaultCapacity )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr< const SolutionCache::Entry > SolutionCache::find( const Key &key )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    for ( auto it = _entries.begin(); it != _entries.end(); ++it )
+    {
+        if ( (*it)->key == key )
+        {
+            // moving entry to the front
+            _entries.splice( _entries.begin(), _entries, it );
+            return _entries.front();
+        }
+    }
+
+    return std::shared_ptr< const Entry >();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SolutionCache::insert( const std::shared_ptr< const Entry > &entry )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    if ( _capacity == 0 ) return;
+
+    for ( auto it = _entries.begin(); it != _entries.end(); ++it )
+    {
+        if ( (*it)->key == entry->key )
+        {
+            _entries.erase( it );
+            break;
+        }
+    }
+
+    _entries.push_front( entry );
+
+    trim();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SolutionCache::clear()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    _entries.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+size_t SolutionCache::getCapacity()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    return _capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SolutionCache::setCapacity( size_t capacity )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    _capacity = capacity;
+
+    trim();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SolutionCache::trim()
+{
+    while ( _entries.size() > _capacity )
+    {
+        _entries.pop_back();
+    }
+}
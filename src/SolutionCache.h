@@ -0,0 +1,142 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef SOLUTIONCACHE_H
+#define SOLUTIONCACHE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Process-wide cache of geometry dependent computation results.
+ *
+ * Interpolated full span sections, spanwise basis and factorized equations'
+ * Left-Hand-Side depend only on wing geometry, number of spanwise sections,
+ * number of Fourier series terms and symmetric mode, but not on angles of
+ * attack and flight conditions. Wings sharing the same key reuse them and
+ * skip straight to equations' Right-Hand-Sides and back-substitution.
+ *
+ * Entries are immutable and shared, least recently used entry is removed
+ * when capacity is exceeded. All functions are thread-safe.
+ */
+class SolutionCache
+{
+public:
+
+    static const size_t defaultCapacity = 32;   ///< default maximum number of entries
+
+    /** Cache key. */
+    struct Key
+    {
+        std::vector< double > sections_data;    ///< wing geometry input, 5 x sections
+        int    sections_iterations;             ///< number of spanwise sections
+        int    fourier_accuracy;                ///< number of Fourier series terms
+        bool   symmetric;                       ///< symmetric loading compute mode
+        bool   least_squares;                   ///< least-squares collocation compute mode
+        size_t hash;                            ///< hash of all above values
+
+        /** @brief Computes hash of key values. */
+        void computeHash();
+
+        bool operator== ( const Key &key ) const;
+    };
+
+    /** Cache entry, arrays have the same layout as corresponding Wing members. */
+    struct Entry
+    {
+        Key key;                                    ///< entry key
+
+        std::vector< double > wingspan;             ///< [sections_fullspan]
+        std::vector< double > chord_length;         ///< [sections_fullspan]
+        std::vector< double > lift_curve_slope;     ///< [sections_fullspan]
+        std::vector< double > angle_of_0_lift_deg;  ///< [sections_fullspan]
+        std::vector< double > angle_of_0_lift_rad;  ///< [sections_fullspan]
+        std::vector< double > phi;                  ///< [sections_fullspan]
+        std::vector< double > mu;                   ///< [sections_fullspan]
+
+        int basis_sections;                         ///< number of sections in spanwise basis
+        int basis_terms;                            ///< number of Fourier series terms in spanwise basis
+        std::vector< double > sin_basis;            ///< [basis_sections][basis_terms]
+        std::vector< double > nsin_basis;           ///< [basis_sections][basis_terms]
+
+        std::vector< double > equations_lhs;        ///< [fourier_accuracy][fourier_accuracy]
+        std::vector< double > equations_span;       ///< [fourier_accuracy]
+        std::vector< double > equations_rhs_twist;  ///< [fourier_accuracy]
+        std::vector< double > equations_rhs_unit;   ///< [fourier_accuracy]
+        std::vector< int >    equations_sections;   ///< [fourier_accuracy]
+        std::vector< double > equations_lu;         ///< [size][size]
+        std::vector< int >    equations_piv;        ///< [size]
+    };
+
+    /** @return process-wide cache instance */
+    static SolutionCache* instance();
+
+    /** @brief Constructor. */
+    SolutionCache();
+
+    /**
+     * @brief Finds entry and marks it as most recently used.
+     * @param key entry key
+     * @return entry or null pointer if not found
+     */
+    std::shared_ptr< const Entry > find( const Key &key );
+
+    /**
+     * @brief Inserts entry, replacing entry with the same key if any.
+     * @param entry entry to be inserted
+     */
+    void insert( const std::shared_ptr< const Entry > &entry );
+
+    /** @brief Removes all entries. */
+    void clear();
+
+    /** @return maximum number of entries */
+    size_t getCapacity();
+
+    /**
+     * @brief Sets maximum number of entries, 0 disables caching.
+     * @param capacity maximum number of entries
+     */
+    void setCapacity( size_t capacity );
+
+private:
+
+    std::mutex _mutex;                                      ///< entries mutex
+    std::list< std::shared_ptr< const Entry > > _entries;   ///< entries, most recently used first
+    size_t _capacity;                                       ///< maximum number of entries
+
+    SolutionCache( const SolutionCache & );
+    SolutionCache& operator=( const SolutionCache & );
+
+    /** @brief Removes least recently used entries exceeding capacity. */
+    void trim();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SOLUTIONCACHE_H
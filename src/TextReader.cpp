@@ -0,0 +1,324 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <TextReader.h>
+
+#include <charconv>
+#include <sstream>
+
+////////////////////////////////////////////////////////////////////////////////
+
+TextReader::TextReader() :
+    _begin ( 0 ),
+    _ptr   ( 0 ),
+    _end   ( 0 ),
+    _token ( 0 ),
+    _delimiter ( 0 ),
+    _good  ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TextReader::~TextReader()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TextReader::open( const char *file )
+{
+    close();
+
+    _path = file;
+
+    if ( !_file.open( file ) )
+    {
+        _error = _path + ": cannot open file";
+        return false;
+    }
+
+    _begin = _file.getData();
+    _ptr   = _begin;
+    _end   = _begin + _file.getSize();
+    _token = _begin;
+    _good  = true;
+    _error.clear();
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TextReader::close()
+{
+    _file.close();
+
+    _begin = 0;
+    _ptr   = 0;
+    _end   = 0;
+    _token = 0;
+    _good  = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TextReader::seek( size_t position )
+{
+    _ptr = _begin + ( position < size() ? position : size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TextReader::skip( size_t count )
+{
+    const char *ptr = _ptr;
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+        while ( ptr < _end &&  isSeparator( *ptr ) ) ptr++;
+
+        if ( ptr == _end ) return false;
+
+        while ( ptr < _end && !isSeparator( *ptr ) ) ptr++;
+
+        _ptr = ptr;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TextReader::skipBack( size_t count )
+{
+    const char *ptr = _ptr;
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+        while ( ptr > _begin &&  isSeparator( *( ptr - 1 ) ) ) ptr--;
+
+        if ( ptr == _begin ) return false;
+
+        while ( ptr > _begin && !isSeparator( *( ptr - 1 ) ) ) ptr--;
+
+        _ptr = ptr;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TextReader::skipLine()
+{
+    while ( _ptr < _end && *_ptr != '\n' ) _ptr++;
+
+    if ( _ptr == _end ) return false;
+
+    _ptr++;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TextReader::atEnd()
+{
+    while ( _ptr < _end && isspace( (unsigned char)*_ptr ) ) _ptr++;
+
+    return _ptr == _end;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+char TextReader::peek()
+{
+    return atEnd() ? 0 : *_ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TextReader::setError( const char *message )
+{
+    setError( _token, message );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TextReader::readRow( double *values, int count )
+{
+    for ( int i = 0; i < count && _good; i++ )
+    {
+        skipBlanks();
+
+        if ( i > 0 )
+        {
+            if ( _ptr == _end || *_ptr == '\n' )
+            {
+                setError( _ptr, "too few fields in row" );
+                break;
+            }
+            else if ( *_ptr != _delimiter )
+            {
+                setError( _ptr, "expected delimiter" );
+                break;
+            }
+
+            _ptr++;
+            skipBlanks();
+        }
+
+        if ( _ptr == _end || *_ptr == '\n' || *_ptr == _delimiter )
+        {
+            setError( _ptr, "empty field" );
+            break;
+        }
+
+        *this >> values[ i ];
+    }
+
+    if ( _good )
+    {
+        skipBlanks();
+
+        if ( _ptr < _end && *_ptr != '\n' )
+            setError( _ptr, "too many fields in row" );
+        else
+            skipLine();
+    }
+
+    return _good;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TextReader& TextReader::operator>> ( double &value )
+{
+    if ( !nextToken() ) return *this;
+
+    // std::from_chars does not accept leading plus sign
+    const char *first = _ptr;
+    if ( *first == '+' && first + 1 < _end && *( first + 1 ) != '-' ) first++;
+
+    std::from_chars_result result = std::from_chars( first, _end, value );
+
+    if ( result.ec == std::errc::invalid_argument )
+    {
+        setError( _ptr, "expected floating point number" );
+    }
+    else if ( result.ec == std::errc::result_out_of_range )
+    {
+        setError( _ptr, "floating point number out of range" );
+    }
+    else if ( result.ptr < _end && !isSeparator( *result.ptr ) )
+    {
+        setError( _ptr, "unexpected characters after floating point number" );
+    }
+    else
+    {
+        _ptr = result.ptr;
+    }
+
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TextReader& TextReader::operator>> ( int &value )
+{
+    if ( !nextToken() ) return *this;
+
+    const char *first = _ptr;
+    if ( *first == '+' && first + 1 < _end && *( first + 1 ) != '-' ) first++;
+
+    std::from_chars_result result = std::from_chars( first, _end, value );
+
+    if ( result.ec == std::errc::invalid_argument )
+    {
+        setError( _ptr, "expected integer number" );
+    }
+    else if ( result.ec == std::errc::result_out_of_range )
+    {
+        setError( _ptr, "integer number out of range" );
+    }
+    else if ( result.ptr < _end && !isSeparator( *result.ptr ) )
+    {
+        setError( _ptr, "unexpected characters after integer number" );
+    }
+    else
+    {
+        _ptr = result.ptr;
+    }
+
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TextReader::nextToken()
+{
+    if ( !_good ) return false;
+
+    while ( _ptr < _end && isSeparator( *_ptr ) ) _ptr++;
+
+    _token = _ptr;
+
+    if ( _ptr == _end )
+    {
+        setError( _ptr, "unexpected end of file" );
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TextReader::setError( const char *position, const char *message )
+{
+    if ( !_good || !is_open() ) return;
+
+    _good = false;
+
+    // line and column are computed only on error
+    int line   = 1;
+    int column = 1;
+
+    for ( const char *p = _begin; p < position; p++ )
+    {
+        if ( *p == '\n' )
+        {
+            line++;
+            column = 1;
+        }
+        else
+        {
+            column++;
+        }
+    }
+
+    std::ostringstream ss;
+    ss << _path << ":" << line << ":" << column << ": " << message;
+
+    _error = ss.str();
+}
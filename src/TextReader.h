@@ -0,0 +1,183 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef TEXTREADER_H
+#define TEXTREADER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <ctype.h>
+#include <string>
+
+#include <MappedFile.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Whitespace separated numbers text file reader.
+ *
+ * Whole file is mapped into memory at once and numbers are parsed in place
+ * with std::from_chars, which is locale independent. After the first error
+ * all following reads are ignored and error message with line and column
+ * of the offending token is available.
+ *
+ * Reading position can be stored and restored, and tokens can be skipped
+ * without parsing (forward and backward), so file parts can be read in any
+ * order and only pages which are actually accessed are read from disk.
+ *
+ * Additional delimiter character (e.g. comma for CSV files) can be set,
+ * then tokens are separated by whitespaces or by this character, or file
+ * can be read row by row with exact number of delimited fields per line.
+ */
+class TextReader
+{
+public:
+
+    /** @brief Constructor. */
+    TextReader();
+
+    /** @brief Destructor. */
+    ~TextReader();
+
+    /**
+     * @brief Maps file into memory.
+     * @param file file path
+     * @return true on success and false on failure
+     */
+    bool open( const char *file );
+
+    /** @brief Unmaps file. */
+    void close();
+
+    /** @return true if file is open */
+    bool is_open() const { return _file.isOpen(); }
+
+    /** @return [bytes] file size */
+    size_t size() const { return _file.getSize(); }
+
+    /** @return [bytes] current position */
+    size_t tell() const { return _ptr - _begin; }
+
+    /**
+     * @brief Sets current position.
+     * @param position [bytes] position (not greater than file size)
+     */
+    void seek( size_t position );
+
+    /**
+     * @brief Skips tokens forward without parsing.
+     * @param count number of tokens to be skipped
+     * @return false if end of file has been reached before all tokens were skipped
+     */
+    bool skip( size_t count );
+
+    /**
+     * @brief Skips tokens backward without parsing. After call current
+     * position is at the beginning of the last skipped token.
+     * @param count number of tokens to be skipped
+     * @return false if beginning of file has been reached before all tokens were skipped
+     */
+    bool skipBack( size_t count );
+
+    /**
+     * @brief Sets additional tokens delimiter.
+     * @param delimiter delimiter character (e.g. ','), 0 for whitespaces only
+     */
+    void setDelimiter( char delimiter ) { _delimiter = delimiter; }
+
+    /**
+     * @brief Skips remaining part of the current line.
+     * @return false if end of file has been reached
+     */
+    bool skipLine();
+
+    /** @return true if there are no more tokens (only whitespaces until end of file) */
+    bool atEnd();
+
+    /** @return first character of the next token (without reading it), 0 if there are no more tokens */
+    char peek();
+
+    /** @return true if no error occurred so far */
+    bool good() const { return _good; }
+
+    /** @return error message (with line and column), empty if no error occurred */
+    const std::string& getError() const { return _error; }
+
+    /**
+     * @brief Sets error at the current position, e.g. on invalid value.
+     * @param message error message
+     */
+    void setError( const char *message );
+
+    /**
+     * @brief Reads row of numbers separated by delimiter from the current
+     * line and moves to the next line. Whitespaces around fields are ignored.
+     * Sets error if any field is empty or line has different number of fields.
+     * @param values output values
+     * @param count expected number of fields
+     * @return true on success and false on failure
+     */
+    bool readRow( double *values, int count );
+
+    TextReader& operator>> ( double &value );
+    TextReader& operator>> ( int &value );
+
+private:
+
+    std::string _path;      ///< file path
+    MappedFile _file;       ///< mapped file
+
+    const char *_begin;     ///< file content beginning
+    const char *_ptr;       ///< current position
+    const char *_end;       ///< file content end
+    const char *_token;     ///< last token beginning
+
+    char _delimiter;        ///< additional tokens delimiter, 0 if none
+
+    bool _good;             ///< specifies if no error occurred so far
+    std::string _error;     ///< error message
+
+    TextReader( const TextReader & );
+    TextReader& operator=( const TextReader & );
+
+    /** @return true if character separates tokens (whitespace or delimiter) */
+    bool isSeparator( char c ) const
+    {
+        return isspace( (unsigned char)c ) || ( _delimiter != 0 && c == _delimiter );
+    }
+
+    /** @brief Skips whitespaces within the current line. */
+    void skipBlanks()
+    {
+        while ( _ptr < _end && *_ptr != '\n' && isspace( (unsigned char)*_ptr ) ) _ptr++;
+    }
+
+    /** @brief Skips separators and returns true if there is next token. */
+    bool nextToken();
+
+    /** @brief Sets error at the given position. */
+    void setError( const char *position, const char *message );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // TEXTREADER_H
@@ -0,0 +1,169 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <TextWriter.h>
+
+#include <charconv>
+#include <string.h>
+
+#include <MappedFile.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+// longest shortest round-trip double representation is 24 characters
+// (e.g. -2.2250738585072014e-308), longest int representation is 11
+static const size_t maxNumberLength = 32;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TextWriter::TextWriter( size_t capacity ) :
+    _fp       ( 0 ),
+    _buffer   ( 0 ),
+    _capacity ( capacity < maxNumberLength ? maxNumberLength : capacity ),
+    _size     ( 0 ),
+    _good     ( false )
+{
+    _buffer = new char [ _capacity ];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TextWriter::~TextWriter()
+{
+    close();
+
+    delete [] _buffer;
+    _buffer = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TextWriter::open( const char *file )
+{
+    close();
+
+    _path = file;
+    _temp = _path + ".tmp";
+
+    _fp = fopen( _temp.c_str(), "wb" );
+
+    if ( _fp )
+    {
+        // output is already buffered
+        setvbuf( _fp, 0, _IONBF, 0 );
+    }
+
+    _size = 0;
+    _good = ( _fp != 0 );
+
+    return _good;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TextWriter::close()
+{
+    if ( !_fp ) return false;
+
+    flush();
+
+    if ( fclose( _fp ) != 0 ) _good = false;
+
+    _fp = 0;
+
+    // file which is currently mapped is replaced, not truncated
+    if ( _good ) _good = MappedFile::replace( _temp.c_str(), _path.c_str() );
+
+    if ( !_good ) remove( _temp.c_str() );
+
+    return _good;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TextWriter& TextWriter::operator<< ( double value )
+{
+    reserve( maxNumberLength );
+
+    std::to_chars_result result = std::to_chars( _buffer + _size, _buffer + _capacity, value );
+    _size = result.ptr - _buffer;
+
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TextWriter& TextWriter::operator<< ( int value )
+{
+    reserve( maxNumberLength );
+
+    std::to_chars_result result = std::to_chars( _buffer + _size, _buffer + _capacity, value );
+    _size = result.ptr - _buffer;
+
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TextWriter& TextWriter::operator<< ( char value )
+{
+    reserve( 1 );
+
+    _buffer[ _size++ ] = value;
+
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TextWriter& TextWriter::operator<< ( const char *value )
+{
+    size_t length = strlen( value );
+
+    while ( length > 0 )
+    {
+        reserve( 1 );
+
+        size_t count = _capacity - _size;
+        if ( count > length ) count = length;
+
+        memcpy( _buffer + _size, value, count );
+
+        _size  += count;
+        value  += count;
+        length -= count;
+    }
+
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TextWriter::flush()
+{
+    if ( _fp && _size > 0 )
+    {
+        if ( fwrite( _buffer, 1, _size, _fp ) != _size ) _good = false;
+    }
+
+    _size = 0;
+}
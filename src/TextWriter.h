@@ -0,0 +1,113 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef TEXTWRITER_H
+#define TEXTWRITER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <string>
+
+#include <stdio.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Buffered text file writer.
+ *
+ * Output is collected in a large buffer which is written to file only when
+ * it is full and on close, so no flush is done per line. Numbers are
+ * formatted with std::to_chars, doubles with the shortest representation
+ * which reads back to exactly the same value.
+ *
+ * Output is written to temporary file which replaces given file on close,
+ * so file which is currently mapped (e.g. the one results are lazily read
+ * from) can be written, and file is not changed if writing fails.
+ */
+class TextWriter
+{
+public:
+
+    static const size_t defaultCapacity = 1 << 20;  ///< [bytes] default buffer capacity
+
+    /**
+     * @brief Constructor.
+     * @param capacity [bytes] buffer capacity
+     */
+    TextWriter( size_t capacity = defaultCapacity );
+
+    /** @brief Destructor. Closes file. */
+    ~TextWriter();
+
+    /**
+     * @brief Opens temporary file for writing.
+     * @param file file path
+     * @return true on success and false on failure
+     */
+    bool open( const char *file );
+
+    /**
+     * @brief Writes buffered output, closes file and replaces given file with it.
+     * @return true if all output has been written successfully
+     */
+    bool close();
+
+    /** @return true if file is open */
+    bool is_open() const { return _fp != 0; }
+
+    TextWriter& operator<< ( double value );
+    TextWriter& operator<< ( int value );
+    TextWriter& operator<< ( char value );
+    TextWriter& operator<< ( const char *value );
+
+private:
+
+    std::string _path;      ///< file path
+    std::string _temp;      ///< temporary file path
+
+    FILE *_fp;              ///< file
+
+    char *_buffer;          ///< output buffer
+    size_t _capacity;       ///< [bytes] buffer capacity
+    size_t _size;           ///< [bytes] buffered output size
+
+    bool _good;             ///< specifies if all writes so far have been successful
+
+    TextWriter( const TextWriter & );
+    TextWriter& operator=( const TextWriter & );
+
+    /** @brief Writes buffered output to file. */
+    void flush();
+
+    /**
+     * @brief Makes sure buffer has at least given free space.
+     * @param size [bytes] required free space
+     */
+    inline void reserve( size_t size )
+    {
+        if ( _capacity - _size < size ) flush();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // TEXTWRITER_H
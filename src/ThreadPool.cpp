@@ -0,0 +1,122 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <ThreadPool.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool::ThreadPool( int workers ) :
+    _job ( 0 ),
+    _workers ( workers > 1 ? workers : 1 ),
+    _count ( 0 ),
+    _generation ( 0 ),
+    _pending ( 0 ),
+    _quit ( false )
+{
+    // calling thread is the first worker
+    for ( int i = 1; i < _workers; i++ )
+    {
+        _threads.push_back( std::thread( &ThreadPool::work, this, i ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _quit = true;
+    }
+
+    _cv_start.notify_all();
+
+    for ( size_t i = 0; i < _threads.size(); i++ )
+    {
+        _threads[ i ].join();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::run( int count, const Job &job )
+{
+    if ( _workers < 2 || count < 2 )
+    {
+        job( 0, count );
+        return;
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _job = &job;
+        _count = count;
+        _pending = _workers - 1;
+        _generation++;
+    }
+
+    _cv_start.notify_all();
+
+    runChunk( 0 );
+
+    std::unique_lock< std::mutex > lock( _mutex );
+    _cv_done.wait( lock, [ this ] { return _pending == 0; } );
+    _job = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::runChunk( int worker )
+{
+    int begin = (int)( (long long)_count * worker / _workers );
+    int end   = (int)( (long long)_count * ( worker + 1 ) / _workers );
+
+    if ( begin < end ) (*_job)( begin, end );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::work( int worker )
+{
+    unsigned int generation = 0;
+
+    while ( true )
+    {
+        {
+            std::unique_lock< std::mutex > lock( _mutex );
+            _cv_start.wait( lock, [ & ] { return _quit || _generation != generation; } );
+
+            if ( _quit ) return;
+
+            generation = _generation;
+        }
+
+        runChunk( worker );
+
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            _pending--;
+        }
+
+        _cv_done.notify_one();
+    }
+}
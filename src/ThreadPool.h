@@ -0,0 +1,96 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Fixed size pool of worker threads for data parallel loops.
+ *
+ * Range of iterations is always split into the same contiguous chunks for
+ * given number of workers, and every iteration is executed by exactly one
+ * worker, so results do not depend on threads scheduling.
+ */
+class ThreadPool
+{
+public:
+
+    /** Job executed for range of iterations [begin, end). */
+    typedef std::function< void ( int begin, int end ) > Job;
+
+    /**
+     * @brief Constructor. Starts worker threads.
+     * @param workers number of workers (including calling thread)
+     */
+    ThreadPool( int workers );
+
+    /** @brief Destructor. Stops and joins worker threads. */
+    ~ThreadPool();
+
+    /** @return number of workers (including calling thread) */
+    int getWorkers() const { return _workers; }
+
+    /**
+     * @brief Runs job for iterations [0, count) split across workers.
+     * Calling thread executes first chunk and waits until all chunks are done.
+     * @param count number of iterations
+     * @param job job to be executed for every chunk
+     */
+    void run( int count, const Job &job );
+
+private:
+
+    std::vector< std::thread > _threads;    ///< worker threads
+
+    std::mutex _mutex;                      ///< state mutex
+    std::condition_variable _cv_start;      ///< new job condition
+    std::condition_variable _cv_done;       ///< job done condition
+
+    const Job *_job;                        ///< current job
+    int _workers;                           ///< number of workers
+    int _count;                             ///< current number of iterations
+    unsigned int _generation;               ///< current job generation
+    int _pending;                           ///< number of chunks in progress
+    bool _quit;                             ///< specifies if threads should quit
+
+    ThreadPool( const ThreadPool & );
+    ThreadPool& operator=( const ThreadPool & );
+
+    /** @brief Executes chunk of the current job. */
+    void runChunk( int worker );
+
+    /** @brief Worker thread loop. */
+    void work( int worker );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // THREADPOOL_H
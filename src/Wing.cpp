@@ -22,9 +22,13 @@
 
 #include <Wing.h>
 
+#include <algorithm>
 #include <fstream>
+#include <vector>
 
 #include <GaussJordan.h>
+#include <Matrix.h>
+#include <TextWriter.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -33,6 +37,12 @@ Wing::Wing() :
 {
     // setting file_name
     file_name[0] = '\0';
+    file_binary  = false;
+    binary_file  = 0;
+    lazy_reader  = 0;
+    lazy_loading = false;
+    saved_results   = SavedAll;
+    results_partial = false;
     
     // angle of attack iteration data
     aoa_start      = 0.0;
@@ -50,10 +60,31 @@ Wing::Wing() :
     
     // Fourier series data
     fourier_accuracy   = 1;
-    old_accuracy       = 0;
-    old_aoa_iterations = 0;
+    
+    // compute modes
+    superposition = false;
+    symmetric     = false;
+    least_squares = false;
+    
+    // incremental computations data
+    dirty = DirtyAll;
+    computed_velocity = 0.0;
+    
+    // threads data
+    threads = 1;
+    pool    = 0;
+    
+    // timing data
+    compute_time = 0.0;
+    
+    for ( int i = 0; i < StagesCount; i++ )
+    {
+        stage_time[i] = 0.0;
+    }
     
     // setting pointers at null address
+    angle_of_attack_deg = 0;
+    angle_of_attack_rad = 0;
     wingspan            = 0;
     chord_length        = 0;
     lift_curve_slope    = 0;
@@ -61,11 +92,22 @@ Wing::Wing() :
     angle_of_0_lift_rad = 0;
     phi = 0;
     mu  = 0;
+    sin_basis  = 0;
+    nsin_basis = 0;
+    basis_sections = 0;
+    basis_terms    = 0;
     
     equations_lhs  = 0;
     equations_rhs  = 0;
     equations_span = 0;
+    equations_rhs_twist = 0;
+    equations_rhs_unit  = 0;
+    equations_sections  = 0;
+    equations_lu   = 0;
+    equations_piv  = 0;
     fourier_terms  = 0;
+    fourier_terms_twist = 0;
+    fourier_terms_unit  = 0;
     gamma          = 0;
     lift_coefficient_distribution = 0;
     induced_velocity_distribution = 0;
@@ -88,6 +130,9 @@ Wing::Wing() :
 Wing::~Wing()
 {
     releaseResults() ;
+
+    delete pool ;
+    pool = 0 ;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -148,11 +193,14 @@ bool Wing::addSectionData( double span_y, double le_x, double te_x, double slope
     // recalculate Wing Geometric Data
     calculateGeometry() ;
     
+#   ifdef _DEBUG
     // write Wing::sections_data array to file
     writeWingInputToFile() ;
+#   endif
     
     // setting Wing::results_uptodate as FALSE
     results_uptodate = false ;
+    dirty |= DirtyGeometry ;
     
     // return TRUE on success
     return true ;
@@ -170,64 +218,141 @@ bool Wing::compute( void )
     // if there is no parameters saved
     if ( ! parameters_saved ) return false;
     
-    // releasing results
-    releaseResults() ;
-    
-#   ifdef _DEBUG
-    // write parameters to file
-    writeParametersToFile();
-#   endif
-    
-    // iterate Angle of Attack at first
-    iterateAoA() ;
+    // reseting timing
+    std::chrono::steady_clock::time_point compute_start = std::chrono::steady_clock::now();
     
-#   ifdef _DEBUG
-    // write angle of attack iterations to file
-    writeAoAToFile();
-#   endif
-    
-    // iterate Cross Sections
-    interpolateSections() ;
-    
-#   ifdef _DEBUG
-    // write interpolated sections arrays to file
-    writeInterpolatedToFile();
-#   endif
+    for ( int i = 0; i < StagesCount; i++ ) stage_time[i] = 0.0 ;
     
-    // rewriting sections arrays for full ( NOT semi ) span
-    rewriteSectionsForFullSpan() ;
+    // only stages depending on inputs changed since the last computations are redone
+    bool full = !results_uptodate || ( dirty & DirtyGeometry ) ;
+    bool aoa  = full || ( dirty & DirtyAoA ) ;
     
-    // sorting fulls pan sections
-    sortFullSpanSections() ;
+    // releasing results
+    if ( full ) releaseResults() ;
     
-#   ifdef _DEBUG
-    // write full span sections arrays to file
-    writeFullspanToFile();
-#   endif
+    // geometry dependent results are shared by wings with the same geometry and parameters
+    SolutionCache::Key cache_key ;
+    std::shared_ptr< const SolutionCache::Entry > cached ;
     
-    // create Equations Left-Hand-Side and Right-Hand-Sides (for every Angle of Attack)
-    createEquations() ;
+    if ( full )
+    {
+        createCacheKey( &cache_key ) ;
+        cached = SolutionCache::instance()->find( cache_key ) ;
+    }
     
-#   ifdef _DEBUG
-    // write equations LHS and RHSs to file
-    writeEquationsToFile();
-#   endif
+    if ( aoa )
+    {
+        // allocating angle of attack dependent results arrays
+        allocateResults() ;
+        
+#       ifdef _DEBUG
+        // write parameters to file
+        writeParametersToFile();
+#       endif
+        
+        // iterate Angle of Attack at first
+        startStage() ;
+        iterateAoA() ;
+        finishStage( StageIterateAoA ) ;
+        
+#       ifdef _DEBUG
+        // write angle of attack iterations to file
+        writeAoAToFile();
+#       endif
+    }
     
-    // solve system of linear equations
-    if ( ! solveEquations() ) ret = false ;
+    if ( full && cached )
+    {
+        loadCachedSolution( *cached ) ;
+    }
+    else if ( full )
+    {
+        // iterate Cross Sections
+        startStage() ;
+        interpolateSections() ;
+        finishStage( StageInterpolateSections ) ;
+        
+#       ifdef _DEBUG
+        // write interpolated sections arrays to file
+        writeInterpolatedToFile();
+#       endif
+        
+        // rewriting sections arrays for full ( NOT semi ) span
+        startStage() ;
+        rewriteSectionsForFullSpan() ;
+        finishStage( StageRewriteSectionsForFullSpan ) ;
+        
+        // sorting fulls pan sections
+        startStage() ;
+        sortFullSpanSections() ;
+        finishStage( StageSortFullSpanSections ) ;
+        
+        // tabulating spanwise basis functions
+        startStage() ;
+        calculateBasis() ;
+        finishStage( StageCalculateBasis ) ;
+        
+#       ifdef _DEBUG
+        // write full span sections arrays to file
+        writeFullspanToFile();
+#       endif
+    }
     
-#   ifdef _DEBUG
-    // write Fourier terms to file
-    if ( ret ) writeFourierToFile();
-#   endif
+    if ( aoa )
+    {
+        // create Equations Left-Hand-Side (only if geometry changed) and Right-Hand-Sides (for every Angle of Attack)
+        startStage() ;
+        if ( full && !cached ) createEquations() ;
+        createEquationsRHS() ;
+        finishStage( StageCreateEquations ) ;
+        
+#       ifdef _DEBUG
+        // write equations LHS and RHSs to file
+        writeEquationsToFile();
+#       endif
+        
+        // solve system of linear equations, Left-Hand-Side is factorized only if geometry changed
+        startStage() ;
+        if ( full && !cached )
+        {
+            if ( factorizeEquations() )
+                storeCachedSolution( cache_key ) ;
+            else
+                ret = false ;
+        }
+        if ( ret ) solveEquations() ;
+        finishStage( StageSolveEquations ) ;
+        
+#       ifdef _DEBUG
+        // write Fourier terms to file
+        if ( ret ) writeFourierToFile();
+#       endif
+    }
     
     // calculating wing aerodynamic characteristics
-    if ( ret ) calculateCharacteristics() ;
+    if ( ret )
+    {
+        startStage() ;
+        if ( aoa || computed_velocity <= 0.0 )
+            calculateCharacteristics() ;
+        else if ( fluid_velocity != computed_velocity )
+            rescaleCharacteristics( fluid_velocity / computed_velocity ) ;
+        finishStage( StageCalculateCharacteristics ) ;
+    }
     
     if ( ret )
+    {
         results_uptodate = true ;
+        dirty = 0 ;
+        computed_velocity = fluid_velocity ;
+    }
     else
+    {
         results_uptodate = false ;
+        dirty = DirtyAll ;
+    }
+    
+    compute_time = std::chrono::duration< double >( std::chrono::steady_clock::now() - compute_start ).count() ;
     
     return ret ;
 }
@@ -278,11 +403,14 @@ bool Wing::deleteSectionData( int row )
         // recalculate Wing Geometric Data
         calculateGeometry() ;
 
+#       ifdef _DEBUG
         // write Wing::sections_data array to file
         writeWingInputToFile() ;
+#       endif
 
         // setting Wing::results_uptodate as FALSE
         results_uptodate = false ;
+        dirty |= DirtyGeometry ;
 
         // return TRUE on success
         return true ;
@@ -333,11 +461,14 @@ bool Wing::editSectionData( double span_y, double le_x, double te_x, double slop
         // recalculate Wing Geometric Data
         calculateGeometry() ;
 
+#       ifdef _DEBUG
         // write Wing::sections_data array to file
         writeWingInputToFile() ;
+#       endif
 
         // setting Wing::results_uptodate as FALSE
         results_uptodate = false ;
+        dirty |= DirtyGeometry ;
 
         // return TRUE on success
         return true ;
@@ -351,12 +482,31 @@ bool Wing::editSectionData( double span_y, double le_x, double te_x, double slop
 
 ////////////////////////////////////////////////////////////////////////////////
 
+double Wing::getComputeTime( void )
+{
+    return compute_time ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char* Wing::getFileError( void )
+{
+    return file_error.c_str() ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 double Wing::getAoADeg( int aoa )
 {
     if ( aoa < aoa_iterations )
+    {
+        loadResultsBlock( BlockAoA ) ;
         return angle_of_attack_deg[aoa];
+    }
     else
+    {
         return 0 ;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -399,9 +549,14 @@ double Wing::getAspectRatio( void )
 double Wing::getDragCoef( int aoa )
 {
     if ( aoa < aoa_iterations )
+    {
+        loadResultsBlock( BlockDragCoef ) ;
         return induced_drag_coefficient[aoa] ;
+    }
     else
+    {
         return 0 ;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -409,9 +564,14 @@ double Wing::getDragCoef( int aoa )
 double Wing::getDragCoefDist( int aoa, int section )
 {
     if ( aoa < aoa_iterations && section < sections_fullspan )
+    {
+        loadResultsBlock( BlockDragCoefDist ) ;
         return induced_drag_coefficient_distribution[aoa][section] ;
+    }
     else
-        return 0;
+    {
+        return 0 ;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -419,9 +579,14 @@ double Wing::getDragCoefDist( int aoa, int section )
 double Wing::getGamma( int aoa, int section )
 {
     if ( aoa < aoa_iterations && section < sections_fullspan )
+    {
+        loadResultsBlock( BlockGamma ) ;
         return gamma[aoa][section] ;
+    }
     else
+    {
         return 0 ;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -450,9 +615,14 @@ int Wing::getFourierAccuracy( void )
 double Wing::getLiftCoef( int aoa )
 {
     if ( aoa < aoa_iterations )
+    {
+        loadResultsBlock( BlockLiftCoef ) ;
         return lift_coefficient[aoa] ;
+    }
     else
+    {
         return 0 ;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -460,13 +630,63 @@ double Wing::getLiftCoef( int aoa )
 double Wing::getLiftCoefDist( int aoa, int section )
 {
     if ( aoa < aoa_iterations && section < sections_fullspan )
+    {
+        loadResultsBlock( BlockLiftCoefDist ) ;
         return lift_coefficient_distribution[aoa][section] ;
+    }
+    else
+    {
+        return 0 ;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double Wing::getStageTime( Stage stage )
+{
+    if ( stage >= 0 && stage < StagesCount )
+        return stage_time[stage] ;
     else
         return 0 ;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const char* Wing::getStageName( Stage stage )
+{
+    static const char* names[] = {
+        "iterateAoA",
+        "interpolateSections",
+        "rewriteSectionsForFullSpan",
+        "sortFullSpanSections",
+        "calculateBasis",
+        "createEquations",
+        "solveEquations",
+        "calculateCharacteristics"
+    };
+
+    if ( stage >= 0 && stage < StagesCount )
+        return names[stage] ;
+    else
+        return "" ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Wing::getThreads( void )
+{
+    return threads ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Wing::getSavedResults( void )
+{
+    return saved_results ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 int Wing::getSections( void )
 {
     return sections ;
@@ -548,9 +768,14 @@ double Wing::getTaperRatio( void )
 double Wing::getVelocityDist( int aoa, int section )
 {
     if ( aoa < aoa_iterations && section < sections_fullspan )
+    {
+        loadResultsBlock( BlockVelocityDist ) ;
         return induced_velocity_distribution[aoa][section] ;
+    }
     else
+    {
         return 0 ;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -572,9 +797,23 @@ double Wing::getWingSpan( void )
 double Wing::getWingSpanCoef( int section )
 {
     if ( section < sections_fullspan )
-        return ( 2 * wingspan[section] / wing_span ) ;
+    {
+        loadResultsBlock( BlockFullSpan ) ;
+
+        // full span sections do NOT exist if results cannot be recomputed
+        return wingspan ? ( 2 * wingspan[section] / wing_span ) : 0 ;
+    }
     else
+    {
         return 0 ;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::invalidate( void )
+{
+    dirty = DirtyAll ;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -586,6 +825,34 @@ bool Wing::isParametersSaved( void )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool Wing::isSuperposition( void )
+{
+    return superposition ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Wing::isLazyLoading( void )
+{
+    return lazy_loading ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Wing::isSymmetric( void )
+{
+    return symmetric ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Wing::isLeastSquares( void )
+{
+    return least_squares ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool Wing::isResultsUpToDate( void )
 {
     return results_uptodate ;
@@ -593,19 +860,194 @@ bool Wing::isResultsUpToDate( void )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool Wing::readFromBinaryFile( const char* file )
+{
+    int i ;
+    BinaryFile *bf = new BinaryFile() ;
+
+    if ( !bf->open( file ) )
+    {
+        delete bf ;
+        file_error = std::string( file ) + ": cannot open file or invalid binary file header" ;
+        return false ;
+    }
+
+    BinaryFile::Header &header = bf->getHeader() ;
+
+    // header values are checked against limits before any arrays sizes are
+    // derived from them, so sizes computed below cannot overflow
+    bool valid = header.sections >= 0            && header.sections            <= BinaryFile::maxCount
+              && header.aoa_iterations >= 1      && header.aoa_iterations      <= BinaryFile::maxCount
+              && header.sections_iterations >= 2 && header.sections_iterations <= BinaryFile::maxCount
+              && header.fourier_accuracy >= 1    && header.fourier_accuracy    <= BinaryFile::maxCount
+              && ( header.modes & ~ModesAll ) == 0 ;
+
+    size_t A = valid ? (size_t)header.aoa_iterations : 0 ;
+    size_t S = valid ? 2 * (size_t)header.sections_iterations - 1 : 0 ;
+    size_t F = valid ? (size_t)header.fourier_accuracy : 0 ;
+
+    double *data = valid ? bf->getArray( BinaryFile::SectionsData, 5 * (size_t)header.sections ) : 0 ;
+
+    // full span arrays, equations' span and Left-Hand-Sides are copied
+    double **fullspan[] = { &wingspan, &chord_length, &lift_curve_slope,
+                            &angle_of_0_lift_deg, &angle_of_0_lift_rad, &phi, &mu } ;
+
+    BinaryFile::Array fullspan_arrays[] = { BinaryFile::Wingspan, BinaryFile::ChordLength,
+                                            BinaryFile::LiftCurveSlope, BinaryFile::AngleOf0LiftDeg,
+                                            BinaryFile::AngleOf0LiftRad, BinaryFile::Phi, BinaryFile::Mu } ;
+
+    // angle of attack dependent results are accessed in place
+    BinaryFile::Array results_arrays[ Results::ArraysCount ] = {
+        BinaryFile::AngleOfAttackDeg, BinaryFile::AngleOfAttackRad,
+        BinaryFile::EquationsRHS, BinaryFile::FourierTerms,
+        BinaryFile::Gamma, BinaryFile::LiftCoefDist,
+        BinaryFile::VelocityDist, BinaryFile::DragCoefDist,
+        BinaryFile::LiftCoef, BinaryFile::DragCoef } ;
+
+    double *results_data[ Results::ArraysCount ] ;
+
+    // checking if all arrays exist and have sizes consistent with parameters
+    valid = valid && data != 0 ;
+
+    if ( valid && header.results )
+    {
+        for ( i = 0; i < 7 && valid; i++ )
+        {
+            valid = bf->getArray( fullspan_arrays[i], S ) != 0 ;
+        }
+
+        valid = valid && bf->getArray( BinaryFile::EquationsSpan, F ) != 0 ;
+        valid = valid && bf->getArray( BinaryFile::EquationsLHS, F * F ) != 0 ;
+
+        for ( i = 0; i < Results::ArraysCount && valid; i++ )
+        {
+            size_t count = Results::getCount( (Results::Array)i, A, F, S ) ;
+            results_data[i] = bf->getArray( results_arrays[i], count ) ;
+            valid = results_data[i] != 0 ;
+        }
+    }
+
+    if ( !valid )
+    {
+        delete bf ;
+        file_error = std::string( file ) + ": invalid binary file content" ;
+        return false ;
+    }
+
+    releaseResults() ;
+
+    // reading wing geometry input
+    sections = header.sections ;
+
+    for ( i = 0; i < 5; i++ )
+    {
+        delete [] sections_data[i] ;
+        sections_data[i] = new double [sections] ;
+        memcpy( sections_data[i], data + i * sections, sections * sizeof(double) ) ;
+    }
+
+    // calculating geometry
+    calculateGeometry() ;
+
+    // reading parameters
+    aoa_start           = header.aoa_start ;
+    aoa_finish          = header.aoa_finish ;
+    aoa_iterations      = header.aoa_iterations ;
+    aoa_step            = header.aoa_step ;
+    fluid_velocity      = header.fluid_velocity ;
+    fluid_density       = header.fluid_density ;
+    sections_iterations = header.sections_iterations ;
+    fourier_accuracy    = header.fourier_accuracy ;
+
+    parameters_saved = true ;
+
+    sections_fullspan = 2 * sections_iterations - 1 ;
+
+    results_uptodate = header.results != 0 ;
+
+    if ( results_uptodate )
+    {
+        // results were computed in compute modes stored in file (version 1 files
+        // do not store them, so results are kept in the current modes)
+        if ( header.version > 1 ) setModes( header.modes ) ;
+
+        for ( i = 0; i < 7; i++ )
+        {
+            *fullspan[i] = new double [S] ;
+            memcpy( *fullspan[i], bf->getArray( fullspan_arrays[i], S ), S * sizeof(double) ) ;
+        }
+
+        equations_span = new double [F] ;
+        memcpy( equations_span, bf->getArray( BinaryFile::EquationsSpan, F ), F * sizeof(double) ) ;
+
+        allocateEquationsLHS() ;
+        memcpy( equations_lhs[0], bf->getArray( BinaryFile::EquationsLHS, F * F ), F * F * sizeof(double) ) ;
+
+        // mapped file is released together with results
+        results.attach( aoa_iterations, fourier_accuracy, sections_fullspan, results_data ) ;
+        binary_file = bf ;
+
+        angle_of_attack_deg = results.angle_of_attack_deg ;
+        angle_of_attack_rad = results.angle_of_attack_rad ;
+        equations_rhs = results.equations_rhs ;
+        fourier_terms = results.fourier_terms ;
+        gamma = results.gamma ;
+        lift_coefficient_distribution = results.lift_coefficient_distribution ;
+        induced_velocity_distribution = results.induced_velocity_distribution ;
+        induced_drag_coefficient_distribution = results.induced_drag_coefficient_distribution ;
+        lift_coefficient = results.lift_coefficient ;
+        induced_drag_coefficient = results.induced_drag_coefficient ;
+    }
+    else
+    {
+        delete bf ;
+        allocateResults() ;
+    }
+
+    setFileName( file ) ;
+    file_binary = true ;
+    file_error.clear() ;
+
+    return true ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool Wing::readFromFile( const char* file )
 {
-    int a, i, n ;
-    std::fstream fs( file, std::ios_base::in );
-    
+    int i ;
+
+    if ( BinaryFile::isBinaryFile( file ) )
+    {
+        return readFromBinaryFile( file ) ;
+    }
+
+    TextReader fs;
+    fs.open( file );
+
     if ( fs.is_open() )
     {
+        releaseResults() ;
+
         // reading number of input cross sections
         fs >> sections;
 
+        if ( fs.good() && ( sections < 0 || sections > BinaryFile::maxCount ) )
+        {
+            fs.setError( "invalid number of cross sections" );
+        }
+
+        if ( !fs.good() )
+        {
+            sections = 0 ;
+            file_error = fs.getError() ;
+            return false ;
+        }
+
         // creating wing geometry input arrays
         for ( i = 0; i < 5; i++ )
         {
+            delete [] sections_data[i] ;
             sections_data[i] = new double [sections] ;
         }
 
@@ -632,179 +1074,162 @@ bool Wing::readFromFile( const char* file )
         fs >> sections_iterations;
         fs >> fourier_accuracy;
 
+        // parameters are checked against the same limits as binary files header before
+        // any arrays sizes are derived from them, so sizes computed below cannot overflow
+        if ( fs.good() && ( aoa_iterations      < 1 || aoa_iterations      > BinaryFile::maxCount
+                         || sections_iterations < 2 || sections_iterations > BinaryFile::maxCount
+                         || fourier_accuracy    < 1 || fourier_accuracy    > BinaryFile::maxCount ) )
+        {
+            fs.setError( "invalid computation parameters" );
+        }
+
+        if ( !fs.good() )
+        {
+            aoa_iterations = 1 ;
+            sections_iterations = 2 ;
+            fourier_accuracy = 1 ;
+            file_error = fs.getError() ;
+            return false ;
+        }
+
         parameters_saved = true ;
 
         sections_fullspan = 2 * sections_iterations - 1 ;
 
+        // allocating angle of attack dependent results arrays
+        allocateResults() ;
+
         // checkiing if results exists
         double are_results ;
         fs >> are_results;
 
-        // if so reading results
-        if ( are_results > 0 ) {
-
-            results_uptodate = true ;
-
-            // creating angle of attach arrays
-            angle_of_attack_deg = new double [aoa_iterations] ;
-            angle_of_attack_rad = new double [aoa_iterations] ;
+        // files store saved results flags and compute modes results were computed in
+        // (older files without modes are kept in the current modes)
+        int flags = SavedAll ;
+        int modes = 0 ;
 
-            // reading angle of attack iterations
-            for ( a = 0; a < aoa_iterations; a++ )
-            {
-                fs >> angle_of_attack_deg[a];
-                fs >> angle_of_attack_rad[a];
-            }
+        if ( are_results == 2 || are_results == 3 ) fs >> flags ;
+        if ( are_results == 3 ) fs >> modes ;
 
-            // creating full span arrays
-            wingspan            = new double [sections_fullspan] ;
-            chord_length        = new double [sections_fullspan] ;
-            lift_curve_slope    = new double [sections_fullspan] ;
-            angle_of_0_lift_deg = new double [sections_fullspan] ;
-            angle_of_0_lift_rad = new double [sections_fullspan] ;
-            phi = new double [sections_fullspan] ;
-            mu  = new double [sections_fullspan] ;
+        if ( fs.good() && ( flags & ~SavedAll ) ) fs.setError( "invalid saved results flags" );
+        if ( fs.good() && ( modes & ~ModesAll ) ) fs.setError( "invalid compute modes" );
 
-            // reading full span section data to file
-            for ( i = 0; i < sections_fullspan; i++ )
-            {
-                fs >> wingspan[i];
-                fs >> chord_length[i];
-                fs >> lift_curve_slope[i];
-                fs >> angle_of_0_lift_deg[i];
-                fs >> angle_of_0_lift_rad[i];
-                fs >> phi[i];
-                fs >> mu[i];
-            }
+        if ( fs.good() && are_results == 3 ) setModes( modes ) ;
 
-            // creating equations' span array
-            equations_span = new double [fourier_accuracy] ;
+        // if so reading results
+        if ( are_results > 0 && fs.good() )
+        {
+            results_uptodate = true ;
 
-            // reading equations' span
-            for ( i = 0; i < fourier_accuracy; i++ )
+            // results blocks which were not stored are recomputed on first access
+            for ( i = 0; i < BlocksCount; i++ )
             {
-                fs >> equations_span[i];
+                results_stored[i] = isResultsBlockSaved( (Block)i, flags ) ;
+                results_partial = results_partial || !results_stored[i] ;
             }
 
-            // creating Left-Hand-Sides of equations arrays
-            equations_lhs = new double* [fourier_accuracy] ;
-            for ( i = 0; i < fourier_accuracy; i++ )
+            if ( lazy_loading )
             {
-                equations_lhs[i] = new double [fourier_accuracy] ;
-            }
+                // results blocks are read on first access
+                lazy_reader = new TextReader() ;
 
-            // reading Left-Hand-Sides of equations
-            for ( i = 0; i < fourier_accuracy; i++ )
-            {
-                for ( n = 0; n < fourier_accuracy; n++ )
+                if ( lazy_reader->open( file ) )
                 {
-                    fs >> equations_lhs[i][n];
+                    for ( i = 0; i < BlocksCount; i++ )
+                    {
+                        lazy_located[i] = false ;
+                        lazy_loaded[i]  = false ;
+                    }
+
+                    lazy_offset[0]  = fs.tell() ;
+                    lazy_located[0] = true ;
                 }
-            }
-
-            // creating Right-Hand-Sides of equations arrays and Fouerier series terms array
-            equations_rhs = new double* [aoa_iterations] ;
-            fourier_terms = new double* [aoa_iterations] ;
-            for ( a = 0; a < aoa_iterations; a++ )
-            {
-                equations_rhs[a] = new double [fourier_accuracy] ;
-                fourier_terms[a] = new double [fourier_accuracy] ;
-            }
-
-            // reading Right-Hand-Sides of equations
-            for ( i = 0; i < fourier_accuracy; i++ )
-            {
-                for ( a = 0; a < aoa_iterations; a++ )
+                else
                 {
-                    fs >> equations_rhs[a][i];
+                    fs.setError( "cannot open file for lazy loading" ) ;
                 }
             }
-
-            // reading Fourier series terms
-            for ( n = 0; n < fourier_accuracy; n++ )
+            else
             {
-                for ( a = 0; a < aoa_iterations; a++ )
+                for ( i = 0; i < BlocksCount; i++ )
                 {
-                    fs >> fourier_terms[a][n];
+                    if ( results_stored[i] ) readResultsBlock( fs, (Block)i ) ;
                 }
             }
+        }
 
-            // creating spanwise distribution characteristics' arrays
-            gamma = new double* [aoa_iterations] ;
-            lift_coefficient_distribution = new double* [aoa_iterations] ;
-            induced_velocity_distribution = new double* [aoa_iterations] ;
-            induced_drag_coefficient_distribution = new double* [aoa_iterations] ;
-            for ( a = 0; a < aoa_iterations; a++ )
-            {
-                gamma[a] = new double [sections_fullspan] ;
-                lift_coefficient_distribution[a] = new double [sections_fullspan] ;
-                induced_velocity_distribution[a] = new double [sections_fullspan] ;
-                induced_drag_coefficient_distribution[a] = new double [sections_fullspan] ;
-            }
+        if ( !fs.good() )
+        {
+            results_uptodate = false ;
+            file_error = fs.getError() ;
+            return false ;
+        }
 
-            // reading Wing::gamma (circulation)
-            for ( i = 0; i < sections_fullspan; i++ )
-            {
-                for ( a = 0; a < aoa_iterations; a++ )
-                {
-                    fs >> gamma[a][i];
-                }
-            }
+        fs.close();
 
-            // reading Wing::lift_coefficient_distribution
-            for ( i = 0; i < sections_fullspan; i++ )
-            {
-                for ( a = 0; a < aoa_iterations; a++ )
-                {
-                    fs >> lift_coefficient_distribution[a][i];
-                }
-            }
+        setFileName( file ) ;
+        file_binary = false ;
+        file_error.clear() ;
 
-            // reading Wing::induced_velocity_distribution
-            for ( i = 0; i < sections_fullspan; i++ )
-            {
-                for ( a = 0; a < aoa_iterations; a++ )
-                {
-                    fs >> induced_velocity_distribution[a][i];
-                }
-            }
+        return true ;
+    }
+    else
+    {
+        file_error = fs.getError() ;
+        return false ;
+    }
+}
 
-            // reading Wing::induced_drag_coefficient_distribution
-            for ( i = 0; i < sections_fullspan; i++ )
-            {
-                for ( a = 0; a < aoa_iterations; a++ )
-                {
-                    fs >> induced_drag_coefficient_distribution[a][i];
-                }
-            }
-        }
+////////////////////////////////////////////////////////////////////////////////
 
-        // creating arrays of angle of attack dependent characteristics
-        lift_coefficient = new double [aoa_iterations] ;
-        induced_drag_coefficient = new double [aoa_iterations] ;
+bool Wing::readSectionsFromCSV( const char* file )
+{
+    std::vector< double > data[5] ;
+    int i ;
 
-        // reading Wing::lift_coefficient
-        for ( a = 0; a < aoa_iterations; a++ )
-        {
-            fs >> lift_coefficient[a];
-        }
+    TextReader fs;
+    fs.setDelimiter( ',' );
 
-        // reading Wing::induced_drag_coefficient
-        for ( a = 0; a < aoa_iterations; a++ )
-        {
-            fs >> induced_drag_coefficient[a];
-        }
+    if ( !fs.open( file ) )
+    {
+        file_error = fs.getError() ;
+        return false ;
+    }
 
-        fs.close();
+    // skipping header row
+    char first = fs.peek() ;
+
+    if ( first != 0 && !isdigit( (unsigned char)first ) && first != '-' && first != '+' && first != '.' )
+    {
+        fs.skipLine() ;
+    }
 
-        strcpy( file_name, file ) ;
+    // reading cross sections data sets, exactly 5 fields per row (empty lines are skipped)
+    while ( fs.good() && !fs.atEnd() )
+    {
+        double values[5] ;
 
-        return true ;
+        if ( fs.readRow( values, 5 ) )
+        {
+            for ( i = 0; i < 5; i++ ) data[i].push_back( values[i] ) ;
+        }
     }
-    else
+
+    if ( !fs.good() )
     {
+        file_error = fs.getError() ;
         return false ;
     }
+
+    if ( !setSectionsData( (int)data[0].size(), data[0].data(), data[1].data(), data[2].data(), data[3].data(), data[4].data() ) )
+    {
+        file_error = std::string( file ) + ": invalid cross sections data" ;
+        return false ;
+    }
+
+    file_error.clear() ;
+
+    return true ;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -847,6 +1272,11 @@ bool Wing::setParameters( double a_start, double a_finish, int a_iterations, dou
     // If all parameters are valid delete Wing::equations_lhs and save parameters
     if ( input_valid )
     {
+        // marking results depending on changed parameters
+        if ( s_iterations != sections_iterations || 2 * f_accuracy - 1 != fourier_accuracy ) dirty |= DirtyGeometry ;
+        if ( a_start != aoa_start || a_finish != aoa_finish || a_iterations != aoa_iterations ) dirty |= DirtyAoA ;
+        if ( f_velocity != fluid_velocity || f_density != fluid_density ) dirty |= DirtyFlow ;
+
         aoa_start = a_start ;
         aoa_finish = a_finish ;
         aoa_iterations = a_iterations ;
@@ -862,11 +1292,207 @@ bool Wing::setParameters( double a_start, double a_finish, int a_iterations, dou
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Wing::setLeastSquares( bool enabled )
+{
+    // equations' Left-Hand-Side is different, so everything is recomputed
+    if ( enabled != least_squares ) dirty |= DirtyGeometry ;
+
+    least_squares = enabled ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::setSavedResults( int flags )
+{
+    saved_results = flags & SavedAll ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Wing::setSectionsData( int count, const double* span_y, const double* le_x, const double* te_x,
+                            const double* slope, const double* angle )
+{
+    double* new_sections_data[5] ;
+    const double* data_sets[5] = { span_y, le_x, te_x, slope, angle } ;
+    bool input_valid = true ;
+    int i, k ;
+
+    if ( count < 0 ) return false ;
+
+    for ( i = 0; i < count; i++ )
+    {
+        // Wing Span Y Coordinate cannot be less than 0.0 and Trailing Edge X Coordinate
+        // should be greater than Leading Edge X Coordinate
+        if ( ! ( span_y[i] >= 0.0 ) || ! ( te_x[i] > le_x[i] ) ) return false ;
+    }
+
+    for ( k = 0; k < 5; k++ )
+    {
+        new_sections_data[k] = new double[count] ;
+        std::copy( data_sets[k], data_sets[k] + count, new_sections_data[k] ) ;
+    }
+
+    // sorting once, so uniqueness check requires comparing neighbours only
+    sortArrays( count, new_sections_data, 5 ) ;
+
+    // first cross section must be wing root (Y Coordinate = 0)
+    if ( count > 0 && new_sections_data[0][0] != 0.0 ) input_valid = false ;
+
+    // Wing Span Y Coordinates must be unique
+    for ( i = 1; i < count && input_valid; i++ )
+    {
+        if ( new_sections_data[0][i] == new_sections_data[0][i-1] ) input_valid = false ;
+    }
+
+    for ( k = 0; k < 5; k++ )
+    {
+        if ( input_valid )
+        {
+            delete [] sections_data[k] ;
+            sections_data[k] = new_sections_data[k] ;
+        }
+        else
+        {
+            delete [] new_sections_data[k] ;
+        }
+    }
+
+    if ( !input_valid ) return false ;
+
+    sections = count ;
+
+    // recalculate Wing Geometric Data
+    calculateGeometry() ;
+
+    // setting Wing::results_uptodate as FALSE
+    results_uptodate = false ;
+    dirty |= DirtyGeometry ;
+
+    return true ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::setSuperposition( bool enabled )
+{
+    if ( enabled != superposition ) dirty |= DirtyAoA ;
+
+    superposition = enabled ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::setThreads( int count )
+{
+    if ( count < 1 ) count = 1 ;
+
+    if ( count != threads )
+    {
+        delete pool ;
+        pool = ( count > 1 ) ? new ThreadPool( count ) : 0 ;
+
+        threads = count ;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::setLazyLoading( bool enabled )
+{
+    lazy_loading = enabled ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::setSymmetric( bool enabled )
+{
+    if ( enabled != symmetric ) dirty |= DirtyGeometry ;
+
+    symmetric = enabled ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Wing::writeToBinaryFile( const char* file )
+{
+    // binary files always contain all results
+    if ( results_uptodate ) loadResultsBlocks( SavedAll ) ;
+
+    BinaryFile bf ;
+    BinaryFile::Header &header = bf.getHeader() ;
+
+    header.sections            = sections ;
+    header.aoa_iterations      = aoa_iterations ;
+    header.sections_iterations = sections_iterations ;
+    header.fourier_accuracy    = fourier_accuracy ;
+    header.results             = results_uptodate ? 1 : 0 ;
+    header.modes               = getModes() ;
+    header.aoa_start           = aoa_start ;
+    header.aoa_finish          = aoa_finish ;
+    header.aoa_step            = aoa_step ;
+    header.fluid_velocity      = fluid_velocity ;
+    header.fluid_density       = fluid_density ;
+
+    // wing geometry input is stored as a single 5 x sections array
+    double *data = new double [ 5 * sections ] ;
+
+    for ( int i = 0; i < 5; i++ )
+    {
+        if ( sections > 0 ) memcpy( data + i * sections, sections_data[i], sections * sizeof(double) ) ;
+    }
+
+    bf.setArray( BinaryFile::SectionsData, data, 5 * sections ) ;
+
+    if ( results_uptodate )
+    {
+        size_t A = aoa_iterations ;
+        size_t S = sections_fullspan ;
+        size_t F = fourier_accuracy ;
+
+        bf.setArray( BinaryFile::AngleOfAttackDeg , angle_of_attack_deg , A ) ;
+        bf.setArray( BinaryFile::AngleOfAttackRad , angle_of_attack_rad , A ) ;
+        bf.setArray( BinaryFile::Wingspan         , wingspan            , S ) ;
+        bf.setArray( BinaryFile::ChordLength      , chord_length        , S ) ;
+        bf.setArray( BinaryFile::LiftCurveSlope   , lift_curve_slope    , S ) ;
+        bf.setArray( BinaryFile::AngleOf0LiftDeg  , angle_of_0_lift_deg , S ) ;
+        bf.setArray( BinaryFile::AngleOf0LiftRad  , angle_of_0_lift_rad , S ) ;
+        bf.setArray( BinaryFile::Phi              , phi                 , S ) ;
+        bf.setArray( BinaryFile::Mu               , mu                  , S ) ;
+        bf.setArray( BinaryFile::EquationsSpan    , equations_span      , F ) ;
+        bf.setArray( BinaryFile::EquationsLHS     , equations_lhs[0]    , F * F ) ;
+        bf.setArray( BinaryFile::EquationsRHS     , equations_rhs[0]    , A * F ) ;
+        bf.setArray( BinaryFile::FourierTerms     , fourier_terms[0]    , A * F ) ;
+        bf.setArray( BinaryFile::Gamma            , gamma[0]            , A * S ) ;
+        bf.setArray( BinaryFile::LiftCoefDist     , lift_coefficient_distribution[0]         , A * S ) ;
+        bf.setArray( BinaryFile::VelocityDist     , induced_velocity_distribution[0]         , A * S ) ;
+        bf.setArray( BinaryFile::DragCoefDist     , induced_drag_coefficient_distribution[0] , A * S ) ;
+        bf.setArray( BinaryFile::LiftCoef         , lift_coefficient         , A ) ;
+        bf.setArray( BinaryFile::DragCoef         , induced_drag_coefficient , A ) ;
+    }
+
+    bool success = bf.write( file ) ;
+
+    delete [] data ;
+
+    if ( success )
+    {
+        setFileName( file ) ;
+        file_binary = true ;
+    }
+
+    return success ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool Wing::writeToDefaultFile( void )
 {
     if ( file_name )
     {
-        return writeToFile(file_name);
+        if ( file_binary )
+            return writeToBinaryFile(file_name);
+        else
+            return writeToFile(file_name);
     }
     else
     {
@@ -876,16 +1502,54 @@ bool Wing::writeToDefaultFile( void )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool Wing::writeTimingToFile( const char* file )
+{
+    std::fstream fs( file, std::ios_base::out );
+
+    if ( fs.is_open() )
+    {
+        fs.precision( 9 );
+
+        fs << "{" << std::endl;
+        fs << "    \"compute\": " << compute_time << "," << std::endl;
+        fs << "    \"stages\": {" << std::endl;
+
+        for ( int i = 0; i < StagesCount; i++ )
+        {
+            fs << "        \"" << getStageName( (Stage)i ) << "\": " << stage_time[i] ;
+            fs << ( ( i < StagesCount - 1 ) ? "," : "" ) << std::endl;
+        }
+
+        fs << "    }" << std::endl;
+        fs << "}" << std::endl;
+
+        fs.close();
+
+        return true ;
+    }
+    else
+    {
+        return false ;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool Wing::writeToFile( const char* file )
 {
+    int flags = saved_results & SavedAll ;
+
+    if ( results_uptodate ) loadResultsBlocks( flags ) ;
+
     int a, i, n ;
-    std::fstream fs( file, std::ios_base::out );
+    TextWriter fs;
+    fs.open( file );
     
     if ( fs.is_open() )
     {
 
         // writing number of input cross sections
-        fs << sections << std::endl;
+        fs << sections << '\n';
 
         // writing wing geometry inptu
         for ( i = 0; i < sections; i++ )
@@ -899,7 +1563,7 @@ bool Wing::writeToFile( const char* file )
             fs << sections_data[3][i];
             fs << " ";
             fs << sections_data[4][i];
-            fs << std::endl;
+            fs << '\n';
         }
 
         // writing parameters
@@ -918,14 +1582,18 @@ bool Wing::writeToFile( const char* file )
         fs << sections_iterations;
         fs << " ";
         fs << fourier_accuracy;
-        fs << std::endl;
+        fs << '\n';
 
         // writing results
         if ( results_uptodate )
         {
 
-            // results exists
-            fs << 1 << std::endl;
+            // results exists (files store saved results flags and compute modes, since
+            // results which are not saved are recomputed after reading file and equations'
+            // Left-Hand-Sides depend on modes, e.g. R factor in least-squares mode)
+            fs << 3 << '\n';
+            fs << flags << '\n';
+            fs << getModes() << '\n';
 
             // writing angle of attack iterations
             for ( a = 0; a < aoa_iterations; a++ )
@@ -933,148 +1601,168 @@ bool Wing::writeToFile( const char* file )
                 fs << angle_of_attack_deg[a];
                 fs << " ";
                 fs << angle_of_attack_rad[a];
-                fs << std::endl;
+                fs << '\n';
             }
 
-            // writing full span section data to file
-            for ( i = 0; i < sections_fullspan; i++ )
+            if ( flags & SavedIntermediates )
             {
-                fs << wingspan[i];
-                fs << " ";
-                fs << chord_length[i];
-                fs << " ";
-                fs << lift_curve_slope[i];
-                fs << " ";
-                fs << angle_of_0_lift_deg[i];
-                fs << " ";
-                fs << angle_of_0_lift_rad[i];
-                fs << " ";
-                fs << phi[i];
-                fs << " ";
-                fs << mu[i];
-                fs << std::endl;
-            }
+                // writing full span section data to file
+                for ( i = 0; i < sections_fullspan; i++ )
+                {
+                    fs << wingspan[i];
+                    fs << " ";
+                    fs << chord_length[i];
+                    fs << " ";
+                    fs << lift_curve_slope[i];
+                    fs << " ";
+                    fs << angle_of_0_lift_deg[i];
+                    fs << " ";
+                    fs << angle_of_0_lift_rad[i];
+                    fs << " ";
+                    fs << phi[i];
+                    fs << " ";
+                    fs << mu[i];
+                    fs << '\n';
+                }
 
-            // writing equations' span
-            for ( i = 0; i < fourier_accuracy; i++ )
-            {
-                fs << equations_span[i];
-                fs << std::endl;
-            }
+                // writing equations' span
+                for ( i = 0; i < fourier_accuracy; i++ )
+                {
+                    fs << equations_span[i];
+                    fs << '\n';
+                }
 
-            // writing Left-Hand-Sides of equations
-            for ( i = 0; i < fourier_accuracy; i++ )
-            {
+                // writing Left-Hand-Sides of equations
+                for ( i = 0; i < fourier_accuracy; i++ )
+                {
+                    for ( n = 0; n < fourier_accuracy; n++ )
+                    {
+                        if ( n == fourier_accuracy -1 )
+                            fs << equations_lhs[i][n];
+                        else
+                            fs << equations_lhs[i][n] << " ";
+                    }
+                    fs << '\n';
+                }
+
+                // writing Right-Hand-Sides of equations
+                for ( i = 0; i < fourier_accuracy; i++ )
+                {
+                    for ( a = 0; a < aoa_iterations; a++ )
+                    {
+                        if ( a == aoa_iterations -1 )
+                            fs << equations_rhs[a][i];
+                        else
+                            fs << equations_rhs[a][i] << " ";
+                    }
+                    fs << '\n';
+                }
+
+                // writing Fourier series terms
                 for ( n = 0; n < fourier_accuracy; n++ )
                 {
-                    if ( n == fourier_accuracy -1 )
-                        fs << equations_lhs[i][n];
-                    else
-                        fs << equations_lhs[i][n] << " ";
+                    for ( a = 0; a < aoa_iterations; a++ )
+                    {
+                        if ( a == aoa_iterations -1 )
+                            fs << fourier_terms[a][n];
+                        else
+                            fs << fourier_terms[a][n] << " ";
+                    }
+                    fs << '\n';
                 }
-                fs << std::endl;
             }
 
-            // writing Right-Hand-Sides of equations
-            for ( i = 0; i < fourier_accuracy; i++ )
+            if ( flags & SavedGamma )
             {
-                for ( a = 0; a < aoa_iterations; a++ )
+                // writing Wing::gamma (circulation)
+                for ( i = 0; i < sections_fullspan; i++ )
                 {
-                    if ( a == aoa_iterations -1 )
-                        fs << equations_rhs[a][i];
-                    else
-                        fs << equations_rhs[a][i] << " ";
+                    for ( a = 0; a < aoa_iterations; a++ )
+                    {
+                        if ( a == aoa_iterations -1 )
+                            fs << gamma[a][i];
+                        else
+                            fs << gamma[a][i] << " ";
+                    }
+                    fs << '\n';
                 }
-                fs << std::endl;
             }
 
-            // writing Fourier series terms
-            for ( n = 0; n < fourier_accuracy; n++ )
+            if ( flags & SavedLiftCoefDist )
             {
-                for ( a = 0; a < aoa_iterations; a++ )
+                // writing Wing::lift_coefficient_distribution
+                for ( i = 0; i < sections_fullspan; i++ )
                 {
-                    if ( a == aoa_iterations -1 )
-                        fs << fourier_terms[a][n];
-                    else
-                        fs << fourier_terms[a][n] << " ";
+                    for ( a = 0; a < aoa_iterations; a++ )
+                    {
+                        if ( a == aoa_iterations -1 )
+                            fs << lift_coefficient_distribution[a][i];
+                        else
+                            fs << lift_coefficient_distribution[a][i] << " ";
+                    }
+                    fs << '\n';
                 }
-                fs << std::endl;
             }
 
-            // writing Wing::gamma (circulation)
-            for ( i = 0; i < sections_fullspan; i++ )
+            if ( flags & SavedVelocityDist )
             {
-                for ( a = 0; a < aoa_iterations; a++ )
+                // writing Wing::induced_velocity_distribution
+                for ( i = 0; i < sections_fullspan; i++ )
                 {
-                    if ( a == aoa_iterations -1 )
-                        fs << gamma[a][i];
-                    else
-                        fs << gamma[a][i] << " ";
+                    for ( a = 0; a < aoa_iterations; a++ )
+                    {
+                        if ( a == aoa_iterations -1 )
+                            fs << induced_velocity_distribution[a][i];
+                        else
+                            fs << induced_velocity_distribution[a][i] << " ";
+                    }
+                    fs << '\n';
                 }
-                fs << std::endl;
             }
 
-            // writing Wing::lift_coefficient_distribution
-            for ( i = 0; i < sections_fullspan; i++ )
+            if ( flags & SavedDragCoefDist )
             {
-                for ( a = 0; a < aoa_iterations; a++ )
+                // writing Wing::induced_drag_coefficient_distribution
+                for ( i = 0; i < sections_fullspan; i++ )
                 {
-                    if ( a == aoa_iterations -1 )
-                        fs << lift_coefficient_distribution[a][i];
-                    else
-                        fs << lift_coefficient_distribution[a][i] << " ";
+                    for ( a = 0; a < aoa_iterations; a++ )
+                    {
+                        if ( a == aoa_iterations -1 )
+                            fs << induced_drag_coefficient_distribution[a][i];
+                        else
+                            fs << induced_drag_coefficient_distribution[a][i] << " ";
+                    }
+                    fs << '\n';
                 }
-                fs << std::endl;
             }
 
-            // writing Wing::induced_velocity_distribution
-            for ( i = 0; i < sections_fullspan; i++ )
+            if ( flags & SavedPolar )
             {
+                // writing Wing::lift_coefficient
                 for ( a = 0; a < aoa_iterations; a++ )
                 {
-                    if ( a == aoa_iterations -1 )
-                        fs << induced_velocity_distribution[a][i];
-                    else
-                        fs << induced_velocity_distribution[a][i] << " ";
+                    fs << lift_coefficient[a];
+                    fs << '\n';
                 }
-                fs << std::endl;
-            }
 
-            // writing Wing::induced_drag_coefficient_distribution
-            for ( i = 0; i < sections_fullspan; i++ )
-            {
+                // writing Wing::induced_drag_coefficient
                 for ( a = 0; a < aoa_iterations; a++ )
                 {
-                    if ( a == aoa_iterations -1 )
-                        fs << induced_drag_coefficient_distribution[a][i];
-                    else
-                        fs << induced_drag_coefficient_distribution[a][i] << " ";
+                    fs << induced_drag_coefficient[a];
+                    fs << '\n';
                 }
-                fs << std::endl;
-            }
-
-            // writing Wing::lift_coefficient
-            for ( a = 0; a < aoa_iterations; a++ )
-            {
-                fs << lift_coefficient[a];
-                fs << std::endl;
-            }
-
-            // writing Wing::induced_drag_coefficient
-            for ( a = 0; a < aoa_iterations; a++ )
-            {
-                fs << induced_drag_coefficient[a];
-                fs << std::endl;
             }
 
         } else {
             // results doesnt exist
-            fs << 0 << std::endl;
+            fs << 0 << '\n';
         }
 
-        fs.close();
+        // buffered output is written on close
+        if ( !fs.close() ) return false;
 
-        strcpy( file_name, file );
+        setFileName( file ) ;
+        file_binary = false ;
 
         return true;
     }
@@ -1086,82 +1774,182 @@ bool Wing::writeToFile( const char* file )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Wing::calculateCharacteristics()
+void Wing::allocateEquationsLHS()
 {
-    int a, i, n ;
-    double sum_nAn2, sum_nAnsin, tmp_gamma ;
+    // Left-Hand-Side rows are stored in a single contiguous array
+    equations_lhs = new double* [fourier_accuracy] ;
+    equations_lhs[0] = new double [fourier_accuracy * fourier_accuracy] ;
 
-    sum_nAn2 = 0.0;
+    for ( int i = 1; i < fourier_accuracy; i++ )
+    {
+        equations_lhs[i] = equations_lhs[0] + i * fourier_accuracy ;
+    }
+}
 
-    // creating arrays for every Angle of Attack
-    gamma = new double* [aoa_iterations] ;
-    lift_coefficient_distribution = new double* [aoa_iterations] ;
-    induced_velocity_distribution = new double* [aoa_iterations] ;
-    induced_drag_coefficient_distribution = new double* [aoa_iterations] ;
+////////////////////////////////////////////////////////////////////////////////
 
-    lift_coefficient = new double [aoa_iterations] ;
-    induced_drag_coefficient = new double [aoa_iterations] ;
+void Wing::allocateResults()
+{
+    results.allocate( aoa_iterations, fourier_accuracy, 2 * sections_iterations - 1 ) ;
+
+    angle_of_attack_deg = results.angle_of_attack_deg ;
+    angle_of_attack_rad = results.angle_of_attack_rad ;
+    equations_rhs = results.equations_rhs ;
+    fourier_terms = results.fourier_terms ;
+    gamma = results.gamma ;
+    lift_coefficient_distribution = results.lift_coefficient_distribution ;
+    induced_velocity_distribution = results.induced_velocity_distribution ;
+    induced_drag_coefficient_distribution = results.induced_drag_coefficient_distribution ;
+    lift_coefficient = results.lift_coefficient ;
+    induced_drag_coefficient = results.induced_drag_coefficient ;
+}
 
-    // creating wing span distributions arrays second dimension
-    for ( a = 0; a < aoa_iterations; a++ )
-    {
+////////////////////////////////////////////////////////////////////////////////
 
-        // creating arrays for every Cross Section
-        gamma[a] = new double [sections_fullspan ] ;
-        lift_coefficient_distribution[a] = new double [ sections_fullspan ] ;
-        induced_velocity_distribution[a] = new double [ sections_fullspan ] ;
-        induced_drag_coefficient_distribution[a] = new double [ sections_fullspan ] ;
-    }
+void Wing::calculateBasis()
+{
+    int i, n ;
 
-    // calculating characteristics for every angle of attack
-    for ( a = 0; a < aoa_iterations; a++ )
-    {
-        // start value of temporary coefficients
-        lift_coefficient[a] = 0.0 ;
+    // in symmetric mode only left wing (with plane of symmetry) and odd Fourier series terms are needed
+    basis_sections = symmetric ? sections_iterations : sections_fullspan ;
+    basis_terms    = symmetric ? ( fourier_accuracy + 1 ) / 2 : fourier_accuracy ;
 
-        for ( i = 0; i < sections_fullspan; i++ )
-        {
-            // start values
-            tmp_gamma = 0.0 ;
+    int stride = symmetric ? 2 : 1 ;
+
+    sin_basis  = new double [ basis_sections * basis_terms ] ;
+    nsin_basis = new double [ basis_sections * basis_terms ] ;
+
+    for ( i = 0; i < basis_sections; i++ )
+    {
+        for ( n = 0; n < basis_terms; n++ )
+        {
+            double harmonic = (double)( stride * n ) + 1 ;
+
+            sin_basis[ i * basis_terms + n ]  = sin( harmonic * phi[i] ) ;
+            nsin_basis[ i * basis_terms + n ] = harmonic * sin_basis[ i * basis_terms + n ] ;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::calculateCharacteristics()
+{
+    int a, n ;
+
+    // in linear superposition mode sums are computed only for twist and unit angle of attack solutions
+    int terms_rows = superposition ? 2 : aoa_iterations ;
+    int stride = symmetric ? 2 : 1 ;
+
+    double *sums_gamma  = new double [ terms_rows * basis_sections ] ;
+    double *sums_nAnsin = new double [ terms_rows * basis_sections ] ;
+
+    // Fourier series terms rows are contiguous, so they are copied only if needed
+    double *terms = 0 ;
+
+    if ( superposition || symmetric )
+    {
+        terms = new double [ terms_rows * basis_terms ] ;
+
+        for ( n = 0; n < basis_terms; n++ )
+        {
+            if ( superposition )
+            {
+                terms[n] = fourier_terms_twist[stride*n] ;
+                terms[basis_terms+n] = fourier_terms_unit[stride*n] ;
+            }
+            else
+            {
+                for ( a = 0; a < aoa_iterations; a++ )
+                {
+                    terms[basis_terms*a+n] = fourier_terms[a][stride*n] ;
+                }
+            }
+        }
+    }
+
+    const double *terms_rows_data = terms ? terms : fourier_terms[0] ;
+
+    // sums of Fourier series for every Cross Section and every Angle of Attack
+    // sums_gamma = terms * sin_basis^T and sums_nAnsin = terms * nsin_basis^T
+    if ( superposition )
+    {
+        Matrix::multiplyTransposed( terms_rows, basis_sections, basis_terms, terms_rows_data, sin_basis,  sums_gamma  ) ;
+        Matrix::multiplyTransposed( terms_rows, basis_sections, basis_terms, terms_rows_data, nsin_basis, sums_nAnsin ) ;
+    }
+
+    // calculating characteristics for every angle of attack
+    runParallel( aoa_iterations, [ & ]( int a_begin, int a_end )
+    {
+        int a, i, n ;
+        double sum_nAn2, sum_nAnsin, tmp_gamma ;
+
+        if ( !superposition )
+        {
+            // sums for the current range of Angles of Attack only
+            Matrix::multiplyTransposed( a_end - a_begin, basis_sections, basis_terms, terms_rows_data + basis_terms * a_begin,
+                                        sin_basis,  sums_gamma  + basis_sections * a_begin ) ;
+            Matrix::multiplyTransposed( a_end - a_begin, basis_sections, basis_terms, terms_rows_data + basis_terms * a_begin,
+                                        nsin_basis, sums_nAnsin + basis_sections * a_begin ) ;
+        }
+
+        for ( a = a_begin; a < a_end; a++ )
+        {
+            // start value of temporary coefficients
+            lift_coefficient[a] = 0.0 ;
             sum_nAn2 = 0.0 ;
-            sum_nAnsin = 0.0 ;
 
-            // for every Fourier series term
             for ( n = 0; n < fourier_accuracy; n++ )
             {
-                // calculating gamma (circulation) for single Cross Section and Angle of Attack
-                tmp_gamma = tmp_gamma + sin( ( (double)n + 1 ) * phi[i] ) * fourier_terms[a][n] ;
-
-                // calculating temporary coefficients
-                sum_nAnsin += ( (double)n + 1 ) * sin( ( (double)n + 1 ) * phi[i] ) * fourier_terms[a][n] ;
                 sum_nAn2 += ( (double)n + 1 ) * pow( fourier_terms[a][n], 2 ) ;
             }
 
-            // finishing calculating gamma (circulation)
-            tmp_gamma = tmp_gamma * ( 2 * wing_span * fluid_velocity ) ;
-            gamma[a][i] = tmp_gamma ;
+            for ( i = 0; i < sections_fullspan; i++ )
+            {
+                // in symmetric mode right wing sums are mirrored from left wing
+                int j = ( i < basis_sections ) ? i : sections_fullspan - 1 - i ;
 
-            // calculating lift coef. distribution for single Cross Section and Angle of Attack
-            lift_coefficient_distribution[a][i] = 2 * gamma[a][i] / ( fluid_velocity * chord_length[i] ) ;
+                if ( superposition )
+                {
+                    // linear combination of twist and unit angle of attack sums
+                    tmp_gamma  = sums_gamma[j]  + angle_of_attack_rad[a] * sums_gamma[basis_sections+j] ;
+                    sum_nAnsin = sums_nAnsin[j] + angle_of_attack_rad[a] * sums_nAnsin[basis_sections+j] ;
+                }
+                else
+                {
+                    tmp_gamma  = sums_gamma[basis_sections*a+j] ;
+                    sum_nAnsin = sums_nAnsin[basis_sections*a+j] ;
+                }
 
-            // calculating induced valocity distribution distribution for single Cross Section and Angle of Attack
-            induced_velocity_distribution[a][i] = ( i != 0 && i != sections_fullspan - 1 ) ? ( ( -1 ) / sin( phi[i] ) * sum_nAnsin ) : ( 0 ) ;
+                // finishing calculating gamma (circulation)
+                tmp_gamma = tmp_gamma * ( 2 * wing_span * fluid_velocity ) ;
+                gamma[a][i] = tmp_gamma ;
 
-            // calculating induced drag coef. distribution for single Cross Section and Angle of Attack
-            induced_drag_coefficient_distribution[a][i] = ( -induced_velocity_distribution[a][i] ) * gamma[a][i] / ( fluid_velocity * fluid_velocity * chord_length[i] ) ;
+                // calculating lift coef. distribution for single Cross Section and Angle of Attack
+                lift_coefficient_distribution[a][i] = 2 * gamma[a][i] / ( fluid_velocity * chord_length[i] ) ;
 
-            // calculating lift coef. for single Angle of Attack and whole wing
-            if ( i > 0 ) lift_coefficient[a] += ( wingspan[i] - wingspan[i-1] ) * ( lift_coefficient_distribution[a][i] + lift_coefficient_distribution[a][i - 1] ) / 2 ;
-            //lift_coefficient[a] = sum_nAnsin
-        }
+                // calculating induced valocity distribution distribution for single Cross Section and Angle of Attack
+                // (first basis function is sin( phi ))
+                induced_velocity_distribution[a][i] = ( i != 0 && i != sections_fullspan - 1 ) ? ( ( -1 ) / sin_basis[j*basis_terms] * sum_nAnsin ) : ( 0 ) ;
 
-        lift_coefficient[a] /= wing_span ;
+                // calculating induced drag coef. distribution for single Cross Section and Angle of Attack
+                induced_drag_coefficient_distribution[a][i] = ( -induced_velocity_distribution[a][i] ) * gamma[a][i] / ( fluid_velocity * fluid_velocity * chord_length[i] ) ;
 
-        // calcualting induced drag coef. for single Angle of Attack and whole wing
-        induced_drag_coefficient[a] = pi * aspect_ratio * sum_nAn2 ;
+                // calculating lift coef. for single Angle of Attack and whole wing
+                if ( i > 0 ) lift_coefficient[a] += ( wingspan[i] - wingspan[i-1] ) * ( lift_coefficient_distribution[a][i] + lift_coefficient_distribution[a][i - 1] ) / 2 ;
+                //lift_coefficient[a] = sum_nAnsin
+            }
 
-    }
+            lift_coefficient[a] /= wing_span ;
+
+            // calcualting induced drag coef. for single Angle of Attack and whole wing
+            induced_drag_coefficient[a] = pi * aspect_ratio * sum_nAn2 ;
+        }
+    });
 
+    delete [] terms ;
+    delete [] sums_gamma ;
+    delete [] sums_nAnsin ;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1224,33 +2012,105 @@ bool Wing::checkIfSectionExists( double span_y )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Wing::createEquations()
+void Wing::clearResultsBlock( Block block )
 {
-    int i, a, n, cur_section ;
-    double sin_phi, rhs ;
-    int step = (int)floor( ( sections_iterations - 2.0 ) / ( ( fourier_accuracy + 1.0 ) / 2.0 ) ) ;
+    size_t A = aoa_iterations ;
+    size_t S = sections_fullspan ;
+    size_t F = fourier_accuracy ;
 
-    if ( step < 1 )
-        step = 1 ;
+    switch ( block )
+    {
+    case BlockAoA:
+        std::fill( angle_of_attack_deg, angle_of_attack_deg + A, 0.0 ) ;
+        std::fill( angle_of_attack_rad, angle_of_attack_rad + A, 0.0 ) ;
+        break;
+
+    case BlockFullSpan:
+        if ( !wingspan ) break;
+        std::fill( wingspan            , wingspan            + S, 0.0 ) ;
+        std::fill( chord_length        , chord_length        + S, 0.0 ) ;
+        std::fill( lift_curve_slope    , lift_curve_slope    + S, 0.0 ) ;
+        std::fill( angle_of_0_lift_deg , angle_of_0_lift_deg + S, 0.0 ) ;
+        std::fill( angle_of_0_lift_rad , angle_of_0_lift_rad + S, 0.0 ) ;
+        std::fill( phi , phi + S, 0.0 ) ;
+        std::fill( mu  , mu  + S, 0.0 ) ;
+        break;
+
+    // two-dimensional arrays rows are stored contiguously
+    case BlockEquationsSpan: if ( equations_span ) std::fill( equations_span   , equations_span   + F     , 0.0 ) ; break;
+    case BlockEquationsLHS:  if ( equations_lhs  ) std::fill( equations_lhs[0] , equations_lhs[0] + F * F , 0.0 ) ; break;
+    case BlockEquationsRHS:  std::fill( equations_rhs[0] , equations_rhs[0] + A * F , 0.0 ) ; break;
+    case BlockFourierTerms:  std::fill( fourier_terms[0] , fourier_terms[0] + A * F , 0.0 ) ; break;
+    case BlockGamma:         std::fill( gamma[0]         , gamma[0]         + A * S , 0.0 ) ; break;
+
+    case BlockLiftCoefDist:
+        std::fill( lift_coefficient_distribution[0], lift_coefficient_distribution[0] + A * S, 0.0 ) ;
+        break;
+
+    case BlockVelocityDist:
+        std::fill( induced_velocity_distribution[0], induced_velocity_distribution[0] + A * S, 0.0 ) ;
+        break;
+
+    case BlockDragCoefDist:
+        std::fill( induced_drag_coefficient_distribution[0], induced_drag_coefficient_distribution[0] + A * S, 0.0 ) ;
+        break;
+
+    case BlockLiftCoef: std::fill( lift_coefficient         , lift_coefficient         + A, 0.0 ) ; break;
+    case BlockDragCoef: std::fill( induced_drag_coefficient , induced_drag_coefficient + A, 0.0 ) ; break;
+
+    default:
+        break;
+    }
+}
 
-    // creating first dimension
-    equations_lhs = new double* [fourier_accuracy] ;
-    equations_rhs = new double* [aoa_iterations] ;
+////////////////////////////////////////////////////////////////////////////////
 
-    equations_span = new double [fourier_accuracy] ;
+void Wing::createCacheKey( SolutionCache::Key *key )
+{
+    key->sections_data.resize( 5 * sections ) ;
 
-    // creating second dimension
-    for ( i = 0; i < fourier_accuracy; i++ )
+    for ( int i = 0; i < 5; i++ )
     {
-        equations_lhs[i] = new double [fourier_accuracy] ;
+        for ( int j = 0; j < sections; j++ )
+        {
+            key->sections_data[ i * sections + j ] = sections_data[i][j] ;
+        }
     }
 
-    // creating second dimension
-    for ( a = 0; a < aoa_iterations; a++ )
+    key->sections_iterations = sections_iterations ;
+    key->fourier_accuracy    = fourier_accuracy ;
+    key->symmetric           = symmetric ;
+    key->least_squares       = least_squares ;
+
+    key->computeHash() ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::createEquations()
+{
+    int i, n, cur_section ;
+    double sin_phi ;
+    int step = (int)floor( ( sections_iterations - 2.0 ) / ( ( fourier_accuracy + 1.0 ) / 2.0 ) ) ;
+
+    if ( least_squares )
     {
-        equations_rhs[a] = new double [fourier_accuracy] ;
+        createLeastSquaresEquations() ;
+        return ;
     }
 
+    if ( step < 1 )
+        step = 1 ;
+
+    // creating Left-Hand-Side array
+    allocateEquationsLHS() ;
+
+    equations_span = new double [fourier_accuracy] ;
+
+    equations_rhs_twist = new double [fourier_accuracy] ;
+    equations_rhs_unit  = new double [fourier_accuracy] ;
+    equations_sections  = new int [fourier_accuracy] ;
+
     cur_section = step ;
 
     // calculating linear equations system's matrices for left wing
@@ -1262,14 +2122,13 @@ void Wing::createEquations()
             equations_lhs[i][ n - 1 ] = ( sin( phi[cur_section] ) + ( (double)n ) * mu[cur_section] ) * sin( ( (double)n ) * phi[cur_section] ) ;
         }
 
-        for ( a = 0; a < aoa_iterations; a++ )
-        {
-            sin_phi = sin( phi[cur_section] ) ;
-            rhs = sin_phi * mu[cur_section] *  ( angle_of_attack_rad[a] - angle_of_0_lift_rad[cur_section] );
-            equations_rhs[a][i] = rhs ;
-        }
+        // Right-Hand-Side is affine in angle of attack: twist part and unit angle of attack part
+        sin_phi = sin( phi[cur_section] ) ;
+        equations_rhs_twist[i] = - sin_phi * mu[cur_section] * angle_of_0_lift_rad[cur_section] ;
+        equations_rhs_unit[i]  =   sin_phi * mu[cur_section] ;
 
         equations_span[i] = wingspan[cur_section] ;
+        equations_sections[i] = cur_section ;
 
         cur_section += step ;
     }
@@ -1280,15 +2139,13 @@ void Wing::createEquations()
         equations_lhs[( ( fourier_accuracy + 1) / 2 ) - 1][ n-1 ] = ( sin( phi[sections_iterations - 1] ) + ( (double)n ) * mu[sections_iterations - 1] ) * sin( ( (double)n ) * phi[sections_iterations - 1] ) ;
     }
 
-    for ( a = 0; a < aoa_iterations; a++ )
-    {
-        sin_phi = sin( phi[sections_iterations-1] ) ;
-        rhs = sin_phi * mu[sections_iterations - 1] *  ( angle_of_attack_rad[a] - angle_of_0_lift_rad[sections_iterations - 1] );
-        equations_rhs[a][( ( fourier_accuracy + 1) / 2 ) - 1] = rhs ;
-    }
+    sin_phi = sin( phi[sections_iterations-1] ) ;
+    equations_rhs_twist[( ( fourier_accuracy + 1) / 2 ) - 1] = - sin_phi * mu[sections_iterations - 1] * angle_of_0_lift_rad[sections_iterations - 1] ;
+    equations_rhs_unit[( ( fourier_accuracy + 1) / 2 ) - 1]  =   sin_phi * mu[sections_iterations - 1] ;
 
     //equations_span[( ( fourier_accuracy + 1) / 2 ) - 1] = wingspan[sections_iterations - 1] ;
     equations_span[( ( fourier_accuracy + 1) / 2 ) - 1] = wingspan[sections_iterations - 1] ;
+    equations_sections[( ( fourier_accuracy + 1) / 2 ) - 1] = sections_iterations - 1 ;
 
     cur_section = sections_fullspan - step - 1 ;
 
@@ -1300,16 +2157,133 @@ void Wing::createEquations()
             equations_lhs[i][ n-1 ] = ( sin( phi[cur_section] ) + ( (double)n ) * mu[cur_section] ) * sin( ( (double)n ) * phi[cur_section] ) ;
         }
 
+        sin_phi = sin( phi[cur_section] ) ;
+        equations_rhs_twist[i] = - sin_phi * mu[cur_section] * angle_of_0_lift_rad[cur_section] ;
+        equations_rhs_unit[i]  =   sin_phi * mu[cur_section] ;
+
+        equations_span[i] = wingspan[cur_section] ;
+        equations_sections[i] = cur_section ;
+
+        cur_section = cur_section - step ;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::createLeastSquaresEquations()
+{
+    int i, j, n ;
+
+    // in symmetric mode only odd Fourier series terms (every second column) are unknown
+    // and only equations for left wing and plane of symmetry are written
+    int size   = symmetric ? ( fourier_accuracy + 1 ) / 2 : fourier_accuracy ;
+    int stride = symmetric ? 2 : 1 ;
+
+    // wing tips are skipped, since sin( n * fi ) is zero there
+    int first = 1 ;
+    int last  = symmetric ? sections_iterations - 1 : sections_fullspan - 2 ;
+
+    // sections are processed in chunks appended to triangular factor of previous ones,
+    // so memory does NOT depend on number of sections
+    const int chunk = 256 ;
+
+    allocateEquationsLHS() ;
+
+    equations_span = new double [fourier_accuracy] ;
+
+    equations_rhs_twist = new double [fourier_accuracy] ;
+    equations_rhs_unit  = new double [fourier_accuracy] ;
+    equations_sections  = new int [fourier_accuracy] ;
+
+    // augmented matrix [ A | b_twist b_unit ], first size rows are [ R | Q^T * b ]
+    // of already processed sections, next rows are equations of the current chunk
+    int cols = size + 2 ;
+
+    std::vector< double > qr( ( size + chunk ) * cols, 0.0 ) ;
+
+    for ( int begin = first; begin <= last; begin += chunk )
+    {
+        int count = std::min( chunk, last - begin + 1 ) ;
+
+        for ( j = 0; j < count; j++ )
+        {
+            i = begin + j ;
+
+            double *row = &qr[ ( size + j ) * cols ] ;
+            double sin_phi = sin( phi[i] ) ;
+
+            // plane of symmetry stands for both wings in symmetric mode
+            double weight = ( symmetric && i == sections_iterations - 1 ) ? sqrt( 0.5 ) : 1.0 ;
+
+            for ( n = 0; n < size; n++ )
+            {
+                double n_term = stride * n + 1 ;
+                row[n] = weight * ( sin_phi + n_term * mu[i] ) * sin( n_term * phi[i] ) ;
+            }
+
+            // Right-Hand-Side twist part and unit angle of attack part
+            row[size]     = - weight * sin_phi * mu[i] * angle_of_0_lift_rad[i] ;
+            row[size + 1] =   weight * sin_phi * mu[i] ;
+        }
+
+        Matrix::reduceHouseholder( size + count, size, cols, qr.data() ) ;
+    }
+
+    // rewriting triangular system R * x = Q^T * b into Fourier series terms layout, the same
+    // as used by Wing::factorizeEquations() and Wing::solveEquations() for collocation equations
+    for ( i = 0; i < fourier_accuracy; i++ )
+    {
+        for ( n = 0; n < fourier_accuracy; n++ ) equations_lhs[i][n] = 0.0 ;
+
+        equations_rhs_twist[i] = 0.0 ;
+        equations_rhs_unit[i]  = 0.0 ;
+
+        // least-squares equations are NOT written for any section
+        equations_span[i] = 0.0 ;
+        equations_sections[i] = -1 ;
+    }
+
+    for ( i = 0; i < size; i++ )
+    {
+        for ( n = 0; n < size; n++ )
+        {
+            equations_lhs[i][stride*n] = qr[ i * cols + n ] ;
+        }
+
+        equations_rhs_twist[i] = qr[ i * cols + size ] ;
+        equations_rhs_unit[i]  = qr[ i * cols + size + 1 ] ;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::createEquationsRHS()
+{
+    int a, i, j ;
+
+    if ( least_squares )
+    {
+        // Right-Hand-Side rows are Q^T * b rows of QR reduced least-squares problem, not equations written
+        // for sections, but since Q^T is linear Right-Hand-Side is still affine in angle of attack
         for ( a = 0; a < aoa_iterations; a++ )
         {
-            sin_phi = sin( phi[cur_section] ) ;
-            rhs = sin_phi * mu[cur_section] *  ( angle_of_attack_rad[a] - angle_of_0_lift_rad[cur_section] ) ;
-            equations_rhs[a][i] = rhs ;
+            for ( i = 0; i < fourier_accuracy; i++ )
+            {
+                equations_rhs[a][i] = equations_rhs_twist[i] + angle_of_attack_rad[a] * equations_rhs_unit[i] ;
+            }
         }
 
-        equations_span[i] = wingspan[cur_section] ;
+        return ;
+    }
 
-        cur_section = cur_section - step ;
+    // Wing::equations_rhs_unit is sin( fi ) * mi( fi ) for every equation's section
+    for ( a = 0; a < aoa_iterations; a++ )
+    {
+        for ( i = 0; i < fourier_accuracy; i++ )
+        {
+            j = equations_sections[i] ;
+            equations_rhs[a][i] = equations_rhs_unit[i] * ( angle_of_attack_rad[a] - angle_of_0_lift_rad[j] ) ;
+        }
     }
 }
 
@@ -1347,6 +2321,7 @@ void Wing::interpolateSections()
     double per_step_angle_of_0_lift = ( sections_data[4][current_section + 1] - sections_data[4][current_section] ) / ( sections_data[0][current_section + 1] - sections_data[0][current_section] ) * wingspan_step ;
 
     // setting values of the root section
+    wingspan[0] = i_wingspan ;
     chord_length[0] = sections_data[2][0] - sections_data[1][0] ;
     lift_curve_slope[0] = sections_data[3][0] ;
     angle_of_0_lift_deg[0] = sections_data[4][0] ;
@@ -1446,10 +2421,6 @@ void Wing::iterateAoA()
     else
         aoa_step = 0.0 ;
 
-    // creating AoA deg and rad arrays
-    angle_of_attack_deg = new double[aoa_iterations] ;
-    angle_of_attack_rad = new double[aoa_iterations] ;
-
     // calculating AoAs arrays
     for ( i = 0; i < aoa_iterations; i++ )
     {
@@ -1460,46 +2431,430 @@ void Wing::iterateAoA()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Wing::releaseResults()
+bool Wing::isResultsBlockSaved( Block block, int flags )
 {
-    int i ;
-    // releasing memory
-    for ( i = 0; i < old_accuracy; i++ )
+    switch ( block )
+    {
+        case BlockAoA:             return true ;
+        case BlockGamma:           return ( flags & SavedGamma        ) != 0 ;
+        case BlockLiftCoefDist:    return ( flags & SavedLiftCoefDist ) != 0 ;
+        case BlockVelocityDist:    return ( flags & SavedVelocityDist ) != 0 ;
+        case BlockDragCoefDist:    return ( flags & SavedDragCoefDist ) != 0 ;
+        case BlockLiftCoef:        return ( flags & SavedPolar        ) != 0 ;
+        case BlockDragCoef:        return ( flags & SavedPolar        ) != 0 ;
+        default:                   return ( flags & SavedIntermediates ) != 0 ;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Wing::getModes()
+{
+    return ( superposition ? ModeSuperposition : 0 )
+         | ( symmetric     ? ModeSymmetric     : 0 )
+         | ( least_squares ? ModeLeastSquares  : 0 ) ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::setModes( int modes )
+{
+    superposition = ( modes & ModeSuperposition ) != 0 ;
+    symmetric     = ( modes & ModeSymmetric     ) != 0 ;
+    least_squares = ( modes & ModeLeastSquares  ) != 0 ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::loadCachedSolution( const SolutionCache::Entry &entry )
+{
+    // arrays are copied, so they are owned and released the same as computed ones
+    auto copy = []( const std::vector< double > &src )
+    {
+        double *dst = new double [ src.size() ] ;
+        std::copy( src.begin(), src.end(), dst ) ;
+        return dst ;
+    };
+
+    sections_fullspan = (int)entry.wingspan.size() ;
+
+    wingspan            = copy( entry.wingspan ) ;
+    chord_length        = copy( entry.chord_length ) ;
+    lift_curve_slope    = copy( entry.lift_curve_slope ) ;
+    angle_of_0_lift_deg = copy( entry.angle_of_0_lift_deg ) ;
+    angle_of_0_lift_rad = copy( entry.angle_of_0_lift_rad ) ;
+    phi = copy( entry.phi ) ;
+    mu  = copy( entry.mu ) ;
+
+    basis_sections = entry.basis_sections ;
+    basis_terms    = entry.basis_terms ;
+    sin_basis  = copy( entry.sin_basis ) ;
+    nsin_basis = copy( entry.nsin_basis ) ;
+
+    allocateEquationsLHS() ;
+    std::copy( entry.equations_lhs.begin(), entry.equations_lhs.end(), equations_lhs[0] ) ;
+
+    equations_span      = copy( entry.equations_span ) ;
+    equations_rhs_twist = copy( entry.equations_rhs_twist ) ;
+    equations_rhs_unit  = copy( entry.equations_rhs_unit ) ;
+    equations_lu        = copy( entry.equations_lu ) ;
+
+    equations_sections = new int [ entry.equations_sections.size() ] ;
+    std::copy( entry.equations_sections.begin(), entry.equations_sections.end(), equations_sections ) ;
+
+    equations_piv = new int [ entry.equations_piv.size() ] ;
+    std::copy( entry.equations_piv.begin(), entry.equations_piv.end(), equations_piv ) ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::loadResultsBlocks( int flags )
+{
+    for ( int i = 0; i < BlocksCount; i++ )
+    {
+        if ( isResultsBlockSaved( (Block)i, flags ) ) loadResultsBlock( (Block)i ) ;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::loadResultsBlock( Block block )
+{
+    // recomputing results which were not stored in file
+    if ( results_partial && !results_stored[block] )
+    {
+        if ( !compute() )
+        {
+            // recomputing is not retried and all results values are zeros
+            releaseResults() ;
+            allocateResults() ;
+
+            for ( int i = 0; i < BlocksCount; i++ ) clearResultsBlock( (Block)i ) ;
+
+            file_error = std::string( file_name ) + ": cannot recompute results which were not stored in file" ;
+        }
+
+        return ;
+    }
+
+    if ( !lazy_reader || lazy_loaded[block] ) return ;
+
+    lazy_loaded[block] = true ;
+
+    TextReader &fs = *lazy_reader ;
+
+    if ( locateResultsBlock( block ) )
+    {
+        fs.seek( lazy_offset[block] ) ;
+    }
+    else
+    {
+        fs.setError( "unexpected end of file" ) ;
+    }
+
+    // block arrays are created even if block cannot be read
+    readResultsBlock( fs, block ) ;
+
+    if ( fs.good() )
+    {
+        // position after block is the beginning of the next one
+        if ( block + 1 < BlocksCount && !lazy_located[block + 1] )
+        {
+            lazy_offset[block + 1]  = fs.tell() ;
+            lazy_located[block + 1] = true ;
+        }
+    }
+    else
+    {
+        // values which cannot be read (e.g. from truncated file) are zeros
+        clearResultsBlock( block ) ;
+        file_error = fs.getError() ;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Wing::locateResultsBlock( Block block )
+{
+    if ( lazy_located[block] ) return true ;
+
+    TextReader &fs = *lazy_reader ;
+
+    // nearest located block before and after (or end of file)
+    int before = block ;
+    while ( !lazy_located[before] ) before-- ;
+
+    int after = block + 1 ;
+    while ( after < BlocksCount && !lazy_located[after] ) after++ ;
+
+    size_t tokens_forward  = 0 ;
+    size_t tokens_backward = 0 ;
+
+    for ( int i = before; i < block; i++ ) tokens_forward  += getResultsBlockSize( (Block)i ) ;
+    for ( int i = block; i < after; i++ )  tokens_backward += getResultsBlockSize( (Block)i ) ;
+
+    // tokens are skipped without parsing from the nearer side, so e.g.
+    // polar placed at the end of file is found without scanning whole file
+    bool success ;
+
+    if ( tokens_forward <= tokens_backward )
+    {
+        fs.seek( lazy_offset[before] ) ;
+        success = fs.skip( tokens_forward ) ;
+    }
+    else
+    {
+        fs.seek( ( after < BlocksCount ) ? lazy_offset[after] : fs.size() ) ;
+        success = fs.skipBack( tokens_backward ) ;
+    }
+
+    if ( success )
     {
-        delete [] equations_lhs[i] ;
-        // and setting null address
-        equations_lhs[i] = 0 ;
+        lazy_offset[block]  = fs.tell() ;
+        lazy_located[block] = true ;
     }
 
-    for ( i = 0; i < old_aoa_iterations; i++ )
+    return success ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+size_t Wing::getResultsBlockSize( Block block )
+{
+    if ( !results_stored[block] ) return 0 ;
+
+    size_t A = aoa_iterations ;
+    size_t S = sections_fullspan ;
+    size_t F = fourier_accuracy ;
+
+    switch ( block )
     {
-        delete [] equations_rhs[i] ;
-        delete [] fourier_terms[i] ;
-        delete [] gamma[i] ;
-        delete [] lift_coefficient_distribution[i] ;
-        delete [] induced_velocity_distribution[i] ;
-        delete [] induced_drag_coefficient_distribution[i] ;
-        equations_rhs[i] = 0 ;
-        fourier_terms[i] = 0 ;
-        gamma[i] = 0 ;
-        lift_coefficient_distribution[i] = 0 ;
-        induced_velocity_distribution[i] = 0 ;
-        induced_drag_coefficient_distribution[i] = 0 ;
+        case BlockAoA:             return 2 * A ;
+        case BlockFullSpan:        return 7 * S ;
+        case BlockEquationsSpan:   return F ;
+        case BlockEquationsLHS:    return F * F ;
+        case BlockEquationsRHS:    return F * A ;
+        case BlockFourierTerms:    return F * A ;
+        case BlockGamma:           return S * A ;
+        case BlockLiftCoefDist:    return S * A ;
+        case BlockVelocityDist:    return S * A ;
+        case BlockDragCoefDist:    return S * A ;
+        case BlockLiftCoef:        return A ;
+        case BlockDragCoef:        return A ;
+        default:                   return 0 ;
     }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::readResultsBlock( TextReader &fs, Block block )
+{
+    int a, i, n ;
+
+    switch ( block )
+    {
+    case BlockAoA:
+        // reading angle of attack iterations
+        for ( a = 0; a < aoa_iterations; a++ )
+        {
+            fs >> angle_of_attack_deg[a];
+            fs >> angle_of_attack_rad[a];
+        }
+        break;
+
+    case BlockFullSpan:
+        // creating full span arrays
+        wingspan            = new double [sections_fullspan] ;
+        chord_length        = new double [sections_fullspan] ;
+        lift_curve_slope    = new double [sections_fullspan] ;
+        angle_of_0_lift_deg = new double [sections_fullspan] ;
+        angle_of_0_lift_rad = new double [sections_fullspan] ;
+        phi = new double [sections_fullspan] ;
+        mu  = new double [sections_fullspan] ;
+
+        // reading full span section data to file
+        for ( i = 0; i < sections_fullspan; i++ )
+        {
+            fs >> wingspan[i];
+            fs >> chord_length[i];
+            fs >> lift_curve_slope[i];
+            fs >> angle_of_0_lift_deg[i];
+            fs >> angle_of_0_lift_rad[i];
+            fs >> phi[i];
+            fs >> mu[i];
+        }
+        break;
+
+    case BlockEquationsSpan:
+        // creating equations' span array
+        equations_span = new double [fourier_accuracy] ;
+
+        // reading equations' span
+        for ( i = 0; i < fourier_accuracy; i++ )
+        {
+            fs >> equations_span[i];
+        }
+        break;
+
+    case BlockEquationsLHS:
+        // creating Left-Hand-Sides of equations arrays
+        allocateEquationsLHS() ;
+
+        // reading Left-Hand-Sides of equations
+        for ( i = 0; i < fourier_accuracy; i++ )
+        {
+            for ( n = 0; n < fourier_accuracy; n++ )
+            {
+                fs >> equations_lhs[i][n];
+            }
+        }
+        break;
+
+    case BlockEquationsRHS:
+        // reading Right-Hand-Sides of equations
+        for ( i = 0; i < fourier_accuracy; i++ )
+        {
+            for ( a = 0; a < aoa_iterations; a++ )
+            {
+                fs >> equations_rhs[a][i];
+            }
+        }
+        break;
+
+    case BlockFourierTerms:
+        // reading Fourier series terms
+        for ( n = 0; n < fourier_accuracy; n++ )
+        {
+            for ( a = 0; a < aoa_iterations; a++ )
+            {
+                fs >> fourier_terms[a][n];
+            }
+        }
+        break;
+
+    case BlockGamma:
+        // reading Wing::gamma (circulation)
+        for ( i = 0; i < sections_fullspan; i++ )
+        {
+            for ( a = 0; a < aoa_iterations; a++ )
+            {
+                fs >> gamma[a][i];
+            }
+        }
+        break;
 
+    case BlockLiftCoefDist:
+        // reading Wing::lift_coefficient_distribution
+        for ( i = 0; i < sections_fullspan; i++ )
+        {
+            for ( a = 0; a < aoa_iterations; a++ )
+            {
+                fs >> lift_coefficient_distribution[a][i];
+            }
+        }
+        break;
+
+    case BlockVelocityDist:
+        // reading Wing::induced_velocity_distribution
+        for ( i = 0; i < sections_fullspan; i++ )
+        {
+            for ( a = 0; a < aoa_iterations; a++ )
+            {
+                fs >> induced_velocity_distribution[a][i];
+            }
+        }
+        break;
+
+    case BlockDragCoefDist:
+        // reading Wing::induced_drag_coefficient_distribution
+        for ( i = 0; i < sections_fullspan; i++ )
+        {
+            for ( a = 0; a < aoa_iterations; a++ )
+            {
+                fs >> induced_drag_coefficient_distribution[a][i];
+            }
+        }
+        break;
+
+    case BlockLiftCoef:
+        // reading Wing::lift_coefficient
+        for ( a = 0; a < aoa_iterations; a++ )
+        {
+            fs >> lift_coefficient[a];
+        }
+        break;
+
+    case BlockDragCoef:
+        // reading Wing::induced_drag_coefficient
+        for ( a = 0; a < aoa_iterations; a++ )
+        {
+            fs >> induced_drag_coefficient[a];
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::rescaleCharacteristics( double ratio )
+{
+    // circulation is proportional to fluid velocity, lift coefficient and induced velocity
+    // distributions do NOT depend on it, and induced drag coefficient distribution is
+    // proportional to circulation divided by square of fluid velocity
+    runParallel( aoa_iterations, [ this, ratio ]( int a_begin, int a_end )
+    {
+        for ( int a = a_begin; a < a_end; a++ )
+        {
+            for ( int i = 0; i < sections_fullspan; i++ )
+            {
+                gamma[a][i] *= ratio ;
+                induced_drag_coefficient_distribution[a][i] /= ratio ;
+            }
+        }
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::releaseResults()
+{
+    // releasing memory
+    if ( equations_lhs ) delete [] equations_lhs[0] ;
     delete [] equations_lhs ;
-    delete [] equations_rhs ;
     delete [] equations_span ;
-    delete [] fourier_terms ;
-    delete [] gamma ;
-    delete [] lift_coefficient_distribution ;
-    delete [] induced_velocity_distribution ;
-    delete [] induced_drag_coefficient_distribution ;
-    delete [] lift_coefficient ;
-    delete [] induced_drag_coefficient ;
+    delete [] equations_rhs_twist ;
+    delete [] equations_rhs_unit ;
+    delete [] equations_sections ;
+    delete [] equations_lu ;
+    delete [] equations_piv ;
+    delete [] fourier_terms_twist ;
+    delete [] fourier_terms_unit ;
     equations_lhs = 0 ;
-    equations_rhs = 0 ;
     equations_span = 0 ;
+    equations_rhs_twist = 0 ;
+    equations_rhs_unit = 0 ;
+    equations_sections = 0 ;
+    equations_lu = 0 ;
+    equations_piv = 0 ;
+    fourier_terms_twist = 0 ;
+    fourier_terms_unit = 0 ;
+
+    // intermediate results are needed by incremental computations
+    dirty = DirtyAll ;
+
+    // releasing angle of attack dependent results arena
+    results.release() ;
+    delete binary_file ;
+    binary_file = 0 ;
+    delete lazy_reader ;
+    lazy_reader = 0 ;
+    results_partial = false ;
+    angle_of_attack_deg = 0 ;
+    angle_of_attack_rad = 0 ;
+    equations_rhs = 0 ;
     fourier_terms = 0 ;
     gamma = 0 ;
     lift_coefficient_distribution = 0 ;
@@ -1516,6 +2871,8 @@ void Wing::releaseResults()
     delete [] angle_of_0_lift_rad ;
     delete [] phi ;
     delete [] mu ;
+    delete [] sin_basis ;
+    delete [] nsin_basis ;
 
     // setting null address
     wingspan            = 0;
@@ -1525,10 +2882,18 @@ void Wing::releaseResults()
     angle_of_0_lift_rad = 0;
     phi = 0;
     mu  = 0;
+    sin_basis  = 0;
+    nsin_basis = 0;
+}
 
-    // setting new Wing::old_accuracy and Wing::old_aoa_iterations
-    old_accuracy = fourier_accuracy ;
-    old_aoa_iterations = aoa_iterations ;
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::runParallel( int count, const ThreadPool::Job &job )
+{
+    if ( pool )
+        pool->run( count, job ) ;
+    else
+        job( 0, count ) ;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1552,32 +2917,36 @@ void Wing::rewriteSectionsForFullSpan()
     phi = new double[f_iterations] ;
     mu  = new double[f_iterations] ;
 
-    // left wing tip to wing root (excluded)
+    // semi span stations are ascending from wing root ( wingspan = 0 ) to wing tip, so mirrored
+    // stations are written in reverse order and full span arrays come out sorted by wingspan
+    int root = sections_iterations - 1 ;
+
     for ( i = 0; i < sections_iterations; i++ )
     {
-        f_wingspan[i] = wingspan[i] ;
-        f_chord_length[i] = chord_length[i] ;
-        f_lift_curve_slope[i] = lift_curve_slope[i] ;
-        f_angle_of_0_lift_deg[i] = angle_of_0_lift_deg[i] ;
-        f_angle_of_0_lift_rad[i] = angle_of_0_lift_rad[i] ;
-
-        // calulating fi & mi
-        phi[i] = acos( ( -2 ) * f_wingspan[i] / wing_span ) ;
-        mu[i]  = ( 0.25 * f_chord_length[i] * f_lift_curve_slope[i] ) / wing_span ;
-    }
+        // right wing ( negative wingspan ), wing root written by left wing
+        if ( i > 0 )
+        {
+            f_wingspan[ root - i ] = - wingspan[i] ;
+            f_chord_length[ root - i ] = chord_length[i] ;
+            f_lift_curve_slope[ root - i ] = lift_curve_slope[i] ;
+            f_angle_of_0_lift_deg[ root - i ] = angle_of_0_lift_deg[i] ;
+            f_angle_of_0_lift_rad[ root - i ] = angle_of_0_lift_rad[i] ;
+
+            // calulating fi & mi
+            phi[ root - i ] = acos( ( -2 ) * f_wingspan[ root - i ] / wing_span ) ;
+            mu[ root - i ]  = ( 0.25 * f_chord_length[ root - i ] * f_lift_curve_slope[ root - i ] ) / wing_span ;
+        }
 
-    // wing root (included) to right wing tip
-    for ( i = 1; i < sections_iterations; i++ )
-    {
-        f_wingspan[ i + sections_iterations - 1 ] = - wingspan[i] ;
-        f_chord_length[ i + sections_iterations - 1 ] = chord_length[i] ;
-        f_lift_curve_slope[ i + sections_iterations - 1 ] = lift_curve_slope[i] ;
-        f_angle_of_0_lift_deg[ i + sections_iterations - 1 ] = angle_of_0_lift_deg[i] ;
-        f_angle_of_0_lift_rad[ i + sections_iterations - 1 ] = angle_of_0_lift_rad[i] ;
+        // wing root (included) to left wing tip
+        f_wingspan[ root + i ] = wingspan[i] ;
+        f_chord_length[ root + i ] = chord_length[i] ;
+        f_lift_curve_slope[ root + i ] = lift_curve_slope[i] ;
+        f_angle_of_0_lift_deg[ root + i ] = angle_of_0_lift_deg[i] ;
+        f_angle_of_0_lift_rad[ root + i ] = angle_of_0_lift_rad[i] ;
 
         // calulating fi & mi
-        phi[ i + sections_iterations - 1 ] = acos( ( -2 ) * f_wingspan[ i + sections_iterations - 1 ] / wing_span ) ;
-        mu[ i + sections_iterations - 1 ]  = ( 0.25 * f_chord_length[ i + sections_iterations - 1 ] * f_lift_curve_slope[ i + sections_iterations - 1 ] ) / wing_span ;
+        phi[ root + i ] = acos( ( -2 ) * f_wingspan[ root + i ] / wing_span ) ;
+        mu[ root + i ]  = ( 0.25 * f_chord_length[ root + i ] * f_lift_curve_slope[ root + i ] ) / wing_span ;
     }
 
     // setting number of sections in full span Wing::sections_fullspan
@@ -1601,144 +2970,283 @@ void Wing::rewriteSectionsForFullSpan()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Wing::solveEquations()
+bool Wing::factorizeEquations()
+{
+    int i, n ;
+
+    // in symmetric mode only odd Fourier series terms (every second column) are unknown
+    // and only equations for left wing and plane of symmetry are solved
+    int size   = symmetric ? ( fourier_accuracy + 1 ) / 2 : fourier_accuracy ;
+    int stride = symmetric ? 2 : 1 ;
+
+    equations_lu  = new double [ size * size ] ;
+    equations_piv = new int [ size ] ;
+
+    // copying equations Left-Hand-Side to factorized array
+    for ( n = 0; n < size; n++ )
+    {
+        for ( i = 0; i < size; i++ )
+        {
+            equations_lu[size*n+i] = equations_lhs[n][stride*i] ;
+        }
+    }
+
+    // in least-squares mode Left-Hand-Side is R factor of QR decomposition, which is already
+    // upper triangular, so it is used as U factor with unit L (zeros below diagonal) and no swaps
+    if ( least_squares )
+    {
+        for ( i = 0; i < size; i++ )
+        {
+            equations_piv[i] = i ;
+
+            if ( fabs( equations_lu[size*i+i] ) < 1.0e-14 ) return false ;
+        }
+
+        return true ;
+    }
+
+    // Left-Hand-Side does NOT depend on Angle of Attack, so it is factorized only once
+    // (common sizes by compile-time size specializations, large systems by blocks,
+    // with trailing submatrix updated by Wing::pool threads)
+    if ( GaussJordan::hasFixedSize( size ) )
+    {
+        return GaussJordan::factorizeFixed( size, equations_lu, equations_piv ) != BSC_FAILURE ;
+    }
+
+    return GaussJordan::factorize( size, equations_lu, equations_piv, 1.0e-14, pool ) != BSC_FAILURE ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::solveEquations()
 {
-    bool success = true ;
     int a, i, n = 0 ;
-    double* lhs ;
+    double* lu  = equations_lu ;
+    int*    piv = equations_piv ;
     double* rhs ;
 
-    // creating Wing::fourier_terms array's first dimension
-    fourier_terms = new double* [aoa_iterations] ;
-    // and second dimension
-    for ( a = 0; a < aoa_iterations; a++ ) {
-        fourier_terms[a] = new double [fourier_accuracy] ;
+    // in symmetric mode only odd Fourier series terms (every second column) are unknown
+    // and only equations for left wing and plane of symmetry are solved
+    int size   = symmetric ? ( fourier_accuracy + 1 ) / 2 : fourier_accuracy ;
+    int stride = symmetric ? 2 : 1 ;
+
+    // even Fourier series terms are zero in symmetric mode
+    for ( a = 0; a < aoa_iterations; a++ )
+    {
+        for ( n = 0; n < fourier_accuracy; n++ ) fourier_terms[a][n] = 0.0 ;
     }
 
-    // creating temporary arrays
-    lhs = new double [ fourier_accuracy * fourier_accuracy ] ;
-    rhs = new double [ fourier_accuracy ] ;
+    if ( superposition )
+    {
+        // arrays are kept for angles of attack changes
+        if ( !fourier_terms_twist ) fourier_terms_twist = new double [fourier_accuracy] ;
+        if ( !fourier_terms_unit  ) fourier_terms_unit  = new double [fourier_accuracy] ;
 
-    // iterating over Angle of Attack
-    for ( a = 0; a < aoa_iterations; a++ )
+        for ( n = 0; n < fourier_accuracy; n++ )
+        {
+            fourier_terms_twist[n] = 0.0 ;
+            fourier_terms_unit[n]  = 0.0 ;
+        }
+    }
+
+    // creating temporary array
+    rhs = new double [ ( superposition ? 2 : ( symmetric ? aoa_iterations : 0 ) ) * size ] ;
+
+    // copying equations Right-Hand-Sides to temporary array
+    if ( superposition )
     {
-        // copying equations Right-Hand-Side to temporary array
-        for ( i = 0; i < fourier_accuracy; i++ )
+        // only twist part and unit angle of attack part
+        for ( i = 0; i < size; i++ )
         {
-            rhs[i] = equations_rhs[a][i] ;
-            // copying equations Left-Hand-Side to temporary array
-            for ( n = 0; n < fourier_accuracy; n++ )
+            rhs[i] = equations_rhs_twist[i] ;
+            rhs[size+i] = equations_rhs_unit[i] ;
+        }
+    }
+    else if ( symmetric )
+    {
+        // for every Angle of Attack
+        for ( a = 0; a < aoa_iterations; a++ )
+        {
+            for ( i = 0; i < size; i++ )
             {
-                lhs[fourier_accuracy*n+i] = equations_lhs[n][i] ;
+                rhs[size*a+i] = equations_rhs[a][i] ;
             }
         }
+    }
 
-        // solving system of linear equations for single Angle of Attack
-        if ( GaussJordan::solve( fourier_accuracy, lhs, rhs, rhs ) == BSC_FAILURE )
+    if ( superposition )
+    {
+        // solving system of linear equations for twist part and unit angle of attack part
+        GaussJordan::substituteFixed( size, lu, piv, 2, rhs, rhs ) ;
+
+        for ( i = 0; i < size; i++ )
         {
-            success = false ;
+            fourier_terms_twist[stride*i] = rhs[i] ;
+            fourier_terms_unit[stride*i]  = rhs[size+i] ;
         }
 
-        // copying equation's result
-        for ( i = 0; i < fourier_accuracy; i++ )
+        // Fourier series terms are linear combinations A(alpha) = A_twist + alpha * A_unit
+        runParallel( aoa_iterations, [ this ]( int a_begin, int a_end )
         {
-            fourier_terms[a][i] = rhs[i] ;
-        }
+            for ( int a = a_begin; a < a_end; a++ )
+            {
+                for ( int i = 0; i < fourier_accuracy; i++ )
+                {
+                    fourier_terms[a][i] = fourier_terms_twist[i] + angle_of_attack_rad[a] * fourier_terms_unit[i] ;
+                }
+            }
+        });
+    }
+    else if ( symmetric )
+    {
+        // solving system of linear equations for all Angles of Attack at once
+        runParallel( aoa_iterations, [ this, size, stride, lu, piv, rhs ]( int a_begin, int a_end )
+        {
+            GaussJordan::substituteFixed( size, lu, piv, a_end - a_begin, rhs + size * a_begin, rhs + size * a_begin ) ;
 
+            // copying equations' results
+            for ( int a = a_begin; a < a_end; a++ )
+            {
+                for ( int i = 0; i < size; i++ )
+                {
+                    fourier_terms[a][stride*i] = rhs[size*a+i] ;
+                }
+            }
+        });
+    }
+    else
+    {
+        // Right-Hand-Sides and results rows are contiguous, so all Angles of Attack
+        // are solved at once directly from Wing::equations_rhs to Wing::fourier_terms
+        runParallel( aoa_iterations, [ this, size, lu, piv ]( int a_begin, int a_end )
+        {
+            GaussJordan::substituteFixed( size, lu, piv, a_end - a_begin, equations_rhs[a_begin], fourier_terms[a_begin] ) ;
+        });
     }
 
-    delete [] lhs ;
     delete [] rhs ;
-    lhs = 0 ;
     rhs = 0 ;
+}
 
-    return success ;
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::storeCachedSolution( const SolutionCache::Key &key )
+{
+    if ( SolutionCache::instance()->getCapacity() == 0 ) return ;
+
+    std::shared_ptr< SolutionCache::Entry > entry = std::make_shared< SolutionCache::Entry >() ;
+
+    int S = sections_fullspan ;
+    int B = basis_sections * basis_terms ;
+    int F = fourier_accuracy ;
+    int L = symmetric ? ( fourier_accuracy + 1 ) / 2 : fourier_accuracy ;
+
+    entry->key = key ;
+
+    entry->wingspan            .assign( wingspan            , wingspan            + S ) ;
+    entry->chord_length        .assign( chord_length        , chord_length        + S ) ;
+    entry->lift_curve_slope    .assign( lift_curve_slope    , lift_curve_slope    + S ) ;
+    entry->angle_of_0_lift_deg .assign( angle_of_0_lift_deg , angle_of_0_lift_deg + S ) ;
+    entry->angle_of_0_lift_rad .assign( angle_of_0_lift_rad , angle_of_0_lift_rad + S ) ;
+    entry->phi                 .assign( phi                 , phi                 + S ) ;
+    entry->mu                  .assign( mu                  , mu                  + S ) ;
+
+    entry->basis_sections = basis_sections ;
+    entry->basis_terms    = basis_terms ;
+    entry->sin_basis  .assign( sin_basis  , sin_basis  + B ) ;
+    entry->nsin_basis .assign( nsin_basis , nsin_basis + B ) ;
+
+    entry->equations_lhs       .assign( equations_lhs[0]    , equations_lhs[0]    + F * F ) ;
+    entry->equations_span      .assign( equations_span      , equations_span      + F ) ;
+    entry->equations_rhs_twist .assign( equations_rhs_twist , equations_rhs_twist + F ) ;
+    entry->equations_rhs_unit  .assign( equations_rhs_unit  , equations_rhs_unit  + F ) ;
+    entry->equations_sections  .assign( equations_sections  , equations_sections  + F ) ;
+    entry->equations_lu        .assign( equations_lu        , equations_lu        + L * L ) ;
+    entry->equations_piv       .assign( equations_piv       , equations_piv       + L ) ;
+
+    SolutionCache::instance()->insert( entry ) ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::setFileName( const char* file )
+{
+    // given file may be Wing::file_name itself (e.g. in Wing::writeToDefaultFile())
+    if ( file != file_name ) strcpy( file_name, file ) ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::startStage()
+{
+    stage_start = std::chrono::steady_clock::now() ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::finishStage( Stage stage )
+{
+    stage_time[stage] = std::chrono::duration< double >( std::chrono::steady_clock::now() - stage_start ).count() ;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Wing::sortFullSpanSections()
 {
-    bool sorted ;
-    int i, j ;
-    double temp ;
+    int i ;
 
+    // Wing::rewriteSectionsForFullSpan() creates arrays already sorted, so in common case
+    // only order is checked
     for ( i = 1; i < sections_fullspan; i++ )
     {
-        sorted = true ;
-
-        for ( j = 0; j < sections_fullspan - i; j++ )
+        if ( wingspan[i-1] > wingspan[i] )
         {
-            if ( wingspan[j] > wingspan[j+1] )
-            {
-                // wing span
-                temp = wingspan[j] ;
-                wingspan[j] = wingspan[j+1] ;
-                wingspan[j+1] = temp ;
-                // chord
-                temp = chord_length[j] ;
-                chord_length[j] = chord_length[j+1] ;
-                chord_length[j+1] = temp ;
-                // lift curve slop
-                temp = lift_curve_slope[j] ;
-                lift_curve_slope[j] = lift_curve_slope[j+1] ;
-                lift_curve_slope[j+1] = temp ;
-                // angle of _of_0_lift0 lift
-                temp = angle_of_0_lift_deg[j] ;
-                angle_of_0_lift_deg[j] = angle_of_0_lift_deg[j+1] ;
-                angle_of_0_lift_deg[j+1] = temp ;
-                temp = angle_of_0_lift_rad[j] ;
-                angle_of_0_lift_rad[j] = angle_of_0_lift_rad[j+1] ;
-                angle_of_0_lift_rad[j+1] = temp ;
-                // phi
-                temp     = phi[j];
-                phi[j]   = phi[j+1];
-                phi[j+1] = temp;
-                // mu
-                temp    = mu[j] ;
-                mu[j]   = mu[j+1] ;
-                mu[j+1] = temp ;
-                // keep sorting
-                sorted = false ;
-            }
-        }
+            double* arrays[] = { wingspan, chord_length, lift_curve_slope,
+                                 angle_of_0_lift_deg, angle_of_0_lift_rad, phi, mu } ;
 
-        if ( sorted )
-        {
+            sortArrays( sections_fullspan, arrays, 7 ) ;
             break ;
         }
     }
-
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Wing::sortSectionsData()
 {
-    bool sorted ;
-    int i, j, k ;
-    double temp ;
+    sortArrays( sections, sections_data, 5 ) ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wing::sortArrays( int count, double* arrays[], int arrays_count )
+{
+    int i, k ;
+    const double* key = arrays[0] ;
 
-    for ( i = 1; i < sections; i++ )
+    // sorting permutation index instead of swapping all arrays elements,
+    // stable sort keeps order of equal keys as bubble sort did
+    std::vector< int > index( count ) ;
+
+    for ( i = 0; i < count; i++ )
     {
-        sorted = true ;
+        index[i] = i ;
+    }
 
-        for ( j = 0; j < sections - i; j++ )
+    std::stable_sort( index.begin(), index.end(),
+                      [ key ]( int a, int b ) { return key[a] < key[b] ; } ) ;
+
+    // applying permutation to every array
+    std::vector< double > temp( count ) ;
+
+    for ( k = 0; k < arrays_count; k++ )
+    {
+        for ( i = 0; i < count; i++ )
         {
-            if ( sections_data[0][j] > sections_data[0][j+1] )
-            {
-                for ( k=0; k<5; k++ )
-                {
-                    temp = sections_data[k][j] ;
-                    sections_data[k][j] = sections_data[k][j+1] ;
-                    sections_data[k][j+1] = temp ;
-                }
-                sorted = false ;
-            }
-        }
-        if ( sorted ) {
-            break ;
+            temp[i] = arrays[k][ index[i] ] ;
         }
+
+        std::copy( temp.begin(), temp.end(), arrays[k] ) ;
     }
 }
 
@@ -1747,7 +3255,8 @@ void Wing::sortSectionsData()
 bool Wing::writeAoAToFile()
 {
     int a ;
-    std::fstream fs( "../tmp/tmp.aoa", std::ios_base::out );
+    TextWriter fs;
+    fs.open( "../tmp/tmp.aoa" );
 
     if ( fs.is_open() )
     {
@@ -1756,7 +3265,7 @@ bool Wing::writeAoAToFile()
             fs << angle_of_attack_deg[a];
             fs << "\t";
             fs << angle_of_attack_rad[a];
-            fs << std::endl;
+            fs << '\n';
         }
 
         fs.close();
@@ -1775,7 +3284,8 @@ bool Wing::writeEquationsToFile()
 {
     int a, i, n ;
     bool ret = true ;
-    std::fstream fs( "../tmp/tmp.lhs", std::ios_base::out );
+    TextWriter fs;
+    fs.open( "../tmp/tmp.lhs" );
 
     if ( fs.is_open() )
     {
@@ -1791,7 +3301,7 @@ bool Wing::writeEquationsToFile()
                 fs << "\t";
             }
 
-            fs << std::endl;
+            fs << '\n';
         }
     }
     else
@@ -1813,7 +3323,7 @@ bool Wing::writeEquationsToFile()
                 fs << "\t";
             }
 
-            fs << std::endl;
+            fs << '\n';
         }
 
     }
@@ -1835,7 +3345,8 @@ bool Wing::writeEquationsToFile()
 bool Wing::writeFourierToFile()
 {
     int a, n ;
-    std::fstream fs( "../tmp/tmp.terms", std::ios_base::out );
+    TextWriter fs;
+    fs.open( "../tmp/tmp.terms" );
 
     if ( fs.is_open() )
     {
@@ -1847,7 +3358,7 @@ bool Wing::writeFourierToFile()
                 fs << "\t";
             }
 
-            fs << std::endl;
+            fs << '\n';
         }
 
         fs.close();
@@ -1865,7 +3376,8 @@ bool Wing::writeFourierToFile()
 bool Wing::writeFullspanToFile()
 {
     int i ;
-    std::fstream fs( "../tmp/tmp.fullspan", std::ios_base::out );
+    TextWriter fs;
+    fs.open( "../tmp/tmp.fullspan" );
 
     if ( fs.is_open() )
     {
@@ -1884,7 +3396,7 @@ bool Wing::writeFullspanToFile()
             fs << phi[i];
             fs << "\t";
             fs << mu[i];
-            fs << std::endl;
+            fs << '\n';
         }
 
         fs.close();
@@ -1902,7 +3414,8 @@ bool Wing::writeFullspanToFile()
 bool Wing::writeInterpolatedToFile()
 {
     int i ;
-    std::fstream fs( "../tmp/tmp.interpolated", std::ios_base::out );
+    TextWriter fs;
+    fs.open( "../tmp/tmp.interpolated" );
 
     if ( fs.is_open() )
     {
@@ -1917,7 +3430,7 @@ bool Wing::writeInterpolatedToFile()
             fs << angle_of_0_lift_deg[i];
             fs << "\t";
             fs << angle_of_0_lift_rad[i];
-            fs << std::endl;
+            fs << '\n';
         }
 
         fs.close();
@@ -1934,26 +3447,27 @@ bool Wing::writeInterpolatedToFile()
 
 bool Wing::writeParametersToFile()
 {
-    std::fstream fs( "../tmp/tmp.parameters", std::ios_base::out );
+    TextWriter fs;
+    fs.open( "../tmp/tmp.parameters" );
 
     if ( fs.is_open() )
     {
-        fs << "#Angle of Attack Iteration Start Value [deg]" << std::endl;
-        fs << "aoa_start =  " << aoa_start << std::endl;
-        fs << "\n#Angle of Attack Iteration Finish Value [deg]" << std::endl;
-        fs << "aoa_finish = " << aoa_finish << std::endl;
-        fs << "\n#Angle of Attack Number of Iterations [-]" << std::endl;
-        fs << "aoa_iterations = " << aoa_iterations << std::endl;
-        fs << "\n#Angle of Attack Step [deg]" << std::endl;
-        fs << "aoa_step = " << aoa_step << std::endl;
-        fs << "\n#Fluid Velocity [m/s]" << std::endl;
-        fs << "fluid_velocity = " << fluid_velocity << std::endl;
-        fs << "\n#Fluid Density [kg/cu m]" << std::endl;
-        fs << "fluid_density = " << fluid_density << std::endl;
-        fs << "\n#Number of Cross Sections [-]" << std::endl;
-        fs << "sections_iterations = " << sections_iterations << std::endl;
-        fs << "\n#Fourier Series Accuracy [-]" << std::endl;
-        fs << "fourier_accuracy = " << ( ( fourier_accuracy + 1 ) / 2 ) << std::endl;
+        fs << "#Angle of Attack Iteration Start Value [deg]" << '\n';
+        fs << "aoa_start =  " << aoa_start << '\n';
+        fs << "\n#Angle of Attack Iteration Finish Value [deg]" << '\n';
+        fs << "aoa_finish = " << aoa_finish << '\n';
+        fs << "\n#Angle of Attack Number of Iterations [-]" << '\n';
+        fs << "aoa_iterations = " << aoa_iterations << '\n';
+        fs << "\n#Angle of Attack Step [deg]" << '\n';
+        fs << "aoa_step = " << aoa_step << '\n';
+        fs << "\n#Fluid Velocity [m/s]" << '\n';
+        fs << "fluid_velocity = " << fluid_velocity << '\n';
+        fs << "\n#Fluid Density [kg/cu m]" << '\n';
+        fs << "fluid_density = " << fluid_density << '\n';
+        fs << "\n#Number of Cross Sections [-]" << '\n';
+        fs << "sections_iterations = " << sections_iterations << '\n';
+        fs << "\n#Fourier Series Accuracy [-]" << '\n';
+        fs << "fourier_accuracy = " << ( ( fourier_accuracy + 1 ) / 2 ) << '\n';
 
         fs.close();
 
@@ -1970,7 +3484,8 @@ bool Wing::writeParametersToFile()
 bool Wing::writeWingInputToFile()
 {
     int i ;
-    std::fstream fs( "../tmp/tmp.winginput", std::ios_base::out );
+    TextWriter fs;
+    fs.open( "../tmp/tmp.winginput" );
 
     if ( fs.is_open() )
     {
@@ -1985,7 +3500,7 @@ bool Wing::writeWingInputToFile()
             fs << sections_data[3][i];
             fs << "\t";
             fs << sections_data[4][i];
-            fs << std::endl;
+            fs << '\n';
         }
 
         fs.close();
@@ -24,11 +24,19 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <chrono>
+#include <string>
 #include <iostream>
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
 
+#include <BinaryFile.h>
+#include <Results.h>
+#include <SolutionCache.h>
+#include <TextReader.h>
+#include <ThreadPool.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /** @author Marek Cel (marekcel@marekcel.pl) */
@@ -36,6 +44,38 @@ class Wing
 {
 public:
 
+    /** Computation stages timed by Wing::compute(). */
+    enum Stage
+    {
+        StageIterateAoA = 0,                ///< Wing::iterateAoA()
+        StageInterpolateSections,           ///< Wing::interpolateSections()
+        StageRewriteSectionsForFullSpan,    ///< Wing::rewriteSectionsForFullSpan()
+        StageSortFullSpanSections,          ///< Wing::sortFullSpanSections()
+        StageCalculateBasis,                ///< Wing::calculateBasis()
+        StageCreateEquations,               ///< Wing::createEquations() and Wing::createEquationsRHS()
+        StageSolveEquations,                ///< Wing::factorizeEquations() and Wing::solveEquations()
+        StageCalculateCharacteristics,      ///< Wing::calculateCharacteristics()
+        StagesCount                         ///< number of stages
+    };
+
+    /** Results saved to text files (flags), angles of attack are always saved. */
+    enum SavedResults
+    {
+        SavedPolar          = 0x01,         ///< Wing::lift_coefficient and Wing::induced_drag_coefficient
+        SavedGamma          = 0x02,         ///< Wing::gamma
+        SavedLiftCoefDist   = 0x04,         ///< Wing::lift_coefficient_distribution
+        SavedVelocityDist   = 0x08,         ///< Wing::induced_velocity_distribution
+        SavedDragCoefDist   = 0x10,         ///< Wing::induced_drag_coefficient_distribution
+        SavedIntermediates  = 0x20,         ///< full span sections data, equations and Fourier series terms
+        SavedAll            = 0x3f          ///< all results
+    };
+
+    /**
+     * const char* Wing::getStageName( Stage )
+     * @return computation stage name
+     */
+    static const char* getStageName( Stage stage );
+
     /**
      * Wing::Wing()
      * Wing class constructor.
@@ -59,7 +99,11 @@ public:
 
     /**
      * bool Wing::compute()
-     * Computes aerodynamic characteristics of the wing
+     * Computes aerodynamic characteristics of the wing. Only results depending on inputs changed since
+     * the last computations are recomputed: geometry, number of sections, Fourier series accuracy and
+     * symmetric mode changes redo all stages, angles of attack changes reuse interpolated sections and
+     * factorized equations' Left-Hand-Side, and fluid velocity changes only rescale dimensional results.
+     * Geometry dependent results are also shared between wings through process-wide SolutionCache.
      * @return TRUE on success, FALSE on failure
      */
     bool compute( void );
@@ -81,6 +125,18 @@ public:
      */
     bool editSectionData( double span_y, double le_x, double te_x, double slope, double angle, int row );
 
+    /**
+     * double Wing::getComputeTime()
+     * @return [s] duration of the last Wing::compute() call
+     */
+    double getComputeTime( void );
+
+    /**
+     * const char* Wing::getFileError()
+     * @return error message (with line and column for text files) of the last failed file reading
+     */
+    const char* getFileError( void );
+
     /**
      * double Wing::getAoADeg( int aoa )
      * @return Wing::angle_of_attack_deg[aoa]
@@ -213,6 +269,18 @@ public:
      */
     double getSectionY( int i );
 
+    /**
+     * double Wing::getStageTime( Stage )
+     * @return [s] duration of the given stage in the last Wing::compute() call (0 if stage was not executed)
+     */
+    double getStageTime( Stage stage );
+
+    /**
+     * int Wing::getThreads()
+     * @return Wing::threads
+     */
+    int getThreads( void );
+
     /**
      * double Wing::getTaperRatio()
      * @return Wing::taper_ratio
@@ -243,25 +311,83 @@ public:
      */
     double getWingSpanCoef( int section );
 
+    /**
+     * int Wing::getSavedResults()
+     * @return results saved to text files (Wing::SavedResults flags)
+     */
+    int getSavedResults( void );
+
+    /**
+     * bool Wing::isLazyLoading()
+     * @return TRUE if lazy loading of results from text files is enabled
+     */
+    bool isLazyLoading( void );
+
+    /**
+     * bool Wing::isLeastSquares()
+     * @return Wing::least_squares
+     */
+    bool isLeastSquares( void );
+
     /**
      * bool Wing::isParametersSaved()
      * @return Wing::parameters_saved
      */
     bool isParametersSaved( void );
 
+    /**
+     * bool Wing::isSuperposition()
+     * @return Wing::superposition
+     */
+    bool isSuperposition( void );
+
+    /**
+     * bool Wing::isSymmetric()
+     * @return Wing::symmetric
+     */
+    bool isSymmetric( void );
+
     /**
      * bool Wing::isResultsUpToDate()
      * @return Wing::results_uptodate
      */
     bool isResultsUpToDate( void );
 
+    /**
+     * void Wing::invalidate()
+     * Marks all results as dependent on changed inputs, so next Wing::compute() call redoes all stages
+     * (geometry dependent stages can still be skipped if SolutionCache contains matching entry).
+     */
+    void invalidate( void );
+
+    /**
+     * bool Wing::readFromBinaryFile( const char* file )
+     * Reads wing geometry, computation parameters and results from binary file. File is memory-mapped
+     * and angle of attack dependent results are accessed in place without copying.
+     * @return TRUE on success, FALSE on failure
+     */
+    bool readFromBinaryFile( const char* file );
+
     /**
      * bool Wing::readFromFile( const char* file )
-     * Reads wing geometry, computation parameters and results from file.
+     * Reads wing geometry, computation parameters and results from file. Binary files are detected
+     * and read with Wing::readFromBinaryFile(). Slim files (see Wing::setSavedResults()) also set
+     * compute modes which results were computed in.
      * @return TRUE on success, FALSE on failure
      */
     bool readFromFile( const char* file );
 
+    /**
+     * bool Wing::readSectionsFromCSV( const char* file )
+     * Reads wing cross sections data from comma separated values file and sets them with
+     * Wing::setSectionsData(). Every row contains exactly 5 non-empty fields: Wing Span Y Coordinate,
+     * Leading Edge X Coordinate, Trailing Edge X Coordinate, airfoil lift curve slope and angle of zero
+     * lift. Rows do NOT need to be sorted. Optional header row (not starting with a number) and empty
+     * lines are skipped.
+     * @return TRUE on success, FALSE on failure (see Wing::getFileError(), with offending line number)
+     */
+    bool readSectionsFromCSV( const char* file );
+
     /**
      * bool Wing::setParametres( double, double, int, double, double, int, int )
      * Sets parameters and deletes Wing::equation_lhs array.
@@ -269,13 +395,94 @@ public:
      */
     bool setParameters( double a_start, double a_finish, int a_iterations, double f_velocity, double f_density, int s_iterations, int f_accuracy );
 
+    /**
+     * void Wing::setLazyLoading( bool )
+     * Sets lazy loading of results from text files. In this mode Wing::readFromFile() reads geometry and
+     * parameters only, and every results block is read on the first call of its getter (e.g. polar only is
+     * read by Wing::getLiftCoef() and Wing::getDragCoef()). Blocks are located by skipping numbers without
+     * parsing them, from the beginning or from the end of the file, whichever is closer. Values of blocks
+     * which cannot be read (e.g. from truncated file) are zeros and error is set (see Wing::getFileError()).
+     * Getters are not thread-safe in this mode.
+     */
+    void setLazyLoading( bool enabled );
+
+    /**
+     * void Wing::setLeastSquares( bool )
+     * Sets least-squares collocation compute mode. Instead of exactly satisfying lifting line equation at
+     * Wing::fourier_accuracy selected sections, Fourier series terms minimize sum of squared residuals of
+     * the equation at every interpolated section (by Householder QR decomposition of overdetermined
+     * system, normal equations are NOT formed). Spanwise distributions
+     * are smoother, so the same accuracy is reached with fewer Fourier series terms. Mode is stored
+     * in results files (text and binary) and restored when reading them.
+     */
+    void setLeastSquares( bool enabled );
+
+    /**
+     * void Wing::setSavedResults( int )
+     * Sets results saved by Wing::writeToFile() (Wing::SavedResults flags, Wing::SavedAll by default).
+     * Results which are not saved are recomputed on the first call of their getter after reading file,
+     * in compute modes stored in file (reading file sets them). If recomputing fails all results values
+     * are zeros and error is set (see Wing::getFileError()).
+     */
+    void setSavedResults( int flags );
+
+    /**
+     * bool Wing::setSectionsData( int, const double*, const double*, const double*, const double*, const double* )
+     * Replaces all wing cross sections data sets at once. Data sets do NOT need to be sorted. Unlike
+     * Wing::addSectionData() called for every data set, validation and sorting take O(n log n) time,
+     * geometry is calculated once and nothing is written to file.
+     * @return TRUE on success, FALSE on failure (any Wing Span Y Coordinate is NOT unique or is less
+     * than 0.0 OR any Leading Edge X Coordinate is NOT less than Trailing Edge X Coordinate OR there
+     * is no wing root data set, i.e. Wing Span Y Coordinate equal to 0.0); data are NOT changed on failure
+     */
+    bool setSectionsData( int count, const double* span_y, const double* le_x, const double* te_x,
+                          const double* slope, const double* angle );
+
+    /**
+     * void Wing::setSuperposition( bool )
+     * Sets linear superposition compute mode. Equations' Right-Hand-Sides are affine in angle of attack,
+     * so in this mode only two systems are solved (twist part and unit angle of attack part) and results
+     * for every angle of attack are obtained as linear combinations of these two solutions.
+     */
+    void setSuperposition( bool enabled );
+
+    /**
+     * void Wing::setThreads( int )
+     * Sets number of threads used to compute angles of attack. Angles of attack range is always split
+     * into the same chunks for given number of threads, so results are deterministic.
+     */
+    void setThreads( int count );
+
+    /**
+     * void Wing::setSymmetric( bool )
+     * Sets symmetric loading compute mode. Wing and flow are symmetric, so all even Fourier series terms
+     * are zero. In this mode only odd terms are solved using equations for left wing and plane of symmetry,
+     * and right wing distributions are mirrored from left wing.
+     */
+    void setSymmetric( bool enabled );
+
+    /**
+     * bool Wing::writeToBinaryFile( const char* file )
+     * Writes wing geometry, computation parameters and results to binary file.
+     * @returns TRUE on success, FALSE on failure
+     */
+    bool writeToBinaryFile( const char* file );
+
     /**
      * bool Wing::writeToDefaultFile()
-     * Rewrites wing geometry, computation parameters and results to file if file exists (file_name exists).
+     * Rewrites wing geometry, computation parameters and results to file if file exists (file_name exists)
+     * using the same format the file was read or written with.
      * @returns TRUE on success, FALSE on failure
      */
     bool writeToDefaultFile( void );
 
+    /**
+     * bool Wing::writeTimingToFile( const char* file )
+     * Writes durations of the last Wing::compute() call and its stages to file in JSON format.
+     * @returns TRUE on success, FALSE on failure
+     */
+    bool writeTimingToFile( const char* file );
+
     /**
      * bool Wing::writeToFile( const char* file )
      * Writes wing geometry, computation parameters and results to file.
@@ -285,8 +492,55 @@ public:
 
 private:
 
+    /** Results blocks of text file (in the order they are stored). */
+    enum Block
+    {
+        BlockAoA = 0,                       ///< angles of attack
+        BlockFullSpan,                      ///< full span sections data
+        BlockEquationsSpan,                 ///< equations' span
+        BlockEquationsLHS,                  ///< equations' Left-Hand-Sides
+        BlockEquationsRHS,                  ///< equations' Right-Hand-Sides
+        BlockFourierTerms,                  ///< Fourier series terms
+        BlockGamma,                         ///< Wing::gamma
+        BlockLiftCoefDist,                  ///< Wing::lift_coefficient_distribution
+        BlockVelocityDist,                  ///< Wing::induced_velocity_distribution
+        BlockDragCoefDist,                  ///< Wing::induced_drag_coefficient_distribution
+        BlockLiftCoef,                      ///< Wing::lift_coefficient
+        BlockDragCoef,                      ///< Wing::induced_drag_coefficient
+        BlocksCount                         ///< number of blocks
+    };
+
+    /** Compute modes stored in results files (flags). */
+    enum Mode
+    {
+        ModeSuperposition   = 0x01,         ///< linear superposition compute mode
+        ModeSymmetric       = 0x02,         ///< symmetric loading compute mode
+        ModeLeastSquares    = 0x04,         ///< least-squares collocation compute mode
+        ModesAll            = 0x07          ///< all compute modes
+    };
+
+    /** Inputs changed since the last computations (flags). */
+    enum Dirty
+    {
+        DirtyGeometry   = 0x01,             ///< geometry, number of sections, Fourier series accuracy, symmetric or least-squares mode
+        DirtyAoA        = 0x02,             ///< angles of attack or superposition mode
+        DirtyFlow       = 0x04,             ///< fluid velocity or density
+        DirtyAll        = 0x07              ///< all inputs
+    };
+
     const double pi;                ///< pi number 3.14....
     char     file_name[400];        ///<
+    bool     file_binary;           ///< specifies if Wing::file_name is binary file
+    std::string file_error;         ///< last file reading error message
+    BinaryFile *binary_file;        ///< mapped binary file results are accessed from, null address if none
+    bool     lazy_loading;          ///< specifies if results are read from text files on first access
+    TextReader *lazy_reader;        ///< text file results blocks are read from, null address if none
+    size_t   lazy_offset[BlocksCount];  ///< [bytes] results blocks offsets (if located)
+    bool     lazy_located[BlocksCount]; ///< specifies if results blocks are located
+    bool     lazy_loaded[BlocksCount];  ///< specifies if results blocks are read
+    int      saved_results;         ///< results saved to text files (Wing::SavedResults flags)
+    bool     results_partial;       ///< specifies if some results blocks were not stored in file read
+    bool     results_stored[BlocksCount];   ///< specifies if results blocks were stored in file read
     double   *sections_data[5];     ///<
     double   wing_span;             ///<
     double   wing_area;             ///<
@@ -301,14 +555,24 @@ private:
     int      sections_iterations;   ///<
     int      sections_fullspan;     ///<
     int      fourier_accuracy;      ///<
-    int      old_accuracy;          ///<
-    int      old_aoa_iterations;    ///<
     int      sections;              ///<
     bool     results_uptodate;      ///<
     bool     parameters_saved;      ///<
+    bool     superposition;         ///< specifies if linear superposition compute mode is enabled
+    bool     symmetric;             ///< specifies if symmetric loading compute mode is enabled
+    bool     least_squares;         ///< specifies if least-squares collocation compute mode is enabled
+    int      dirty;                 ///< inputs changed since the last computations (Wing::Dirty flags)
+    double   computed_velocity;     ///< fluid velocity of the last computations
+    int      threads;               ///< number of threads used to compute angles of attack
+    ThreadPool *pool;               ///< thread pool, null address if single thread is used
+    double   compute_time;          ///< [s] duration of the last Wing::compute() call
+    double   stage_time[StagesCount];   ///< [s] durations of the last Wing::compute() call stages
+    std::chrono::steady_clock::time_point stage_start;  ///< current stage start time
 
     // COMPUTATIONS RESULTS
 
+    Results  results;               ///< angle of attack dependent results arena
+
     double   *angle_of_attack_deg;  ///< [deg]
     double   *angle_of_attack_rad;  ///< [rad]
     double   *wingspan;             ///<
@@ -318,10 +582,21 @@ private:
     double   *angle_of_0_lift_rad;  ///< [rad] angle of zero lift
     double   *phi;                  ///<
     double   *mu;                   ///<
+    double   *sin_basis;            ///< spanwise basis sin( n * phi ), basis_sections x basis_terms
+    double   *nsin_basis;           ///< spanwise basis n * sin( n * phi ), basis_sections x basis_terms
+    int      basis_sections;        ///< number of sections in spanwise basis
+    int      basis_terms;           ///< number of Fourier series terms in spanwise basis
     double   **equations_lhs;       ///<
     double   **equations_rhs;       ///<
     double   *equations_span;       ///<
+    double   *equations_rhs_twist;  ///< angle of attack independent part of Right-Hand-Side
+    double   *equations_rhs_unit;   ///< Right-Hand-Side part for unit angle of attack [rad]
+    int      *equations_sections;   ///< full span sections equations are written for
+    double   *equations_lu;         ///< factorized equations' Left-Hand-Side (odd terms only in symmetric mode)
+    int      *equations_piv;        ///< factorized equations' Left-Hand-Side pivots
     double   **fourier_terms;       ///<
+    double   *fourier_terms_twist;  ///< solution for Wing::equations_rhs_twist
+    double   *fourier_terms_unit;   ///< solution for Wing::equations_rhs_unit
     double   **gamma;               ///<
     double   **lift_coefficient_distribution;         ///<
     double   **induced_velocity_distribution;         ///<
@@ -335,9 +610,41 @@ private:
      */
     void calculateCharacteristics( void );
 
+    /**
+     * void Wing::allocateEquationsLHS()
+     * Allocates Wing::equations_lhs with rows stored in a single contiguous array.
+     */
+    void allocateEquationsLHS( void );
+
+    /**
+     * void Wing::allocateResults()
+     * Allocates Wing::results arena and points angle of attack dependent results arrays into it.
+     */
+    void allocateResults( void );
+
+    /**
+     * void Wing::calculateBasis()
+     * Tabulates spanwise basis functions Wing::sin_basis and Wing::nsin_basis for every full span section
+     * and Fourier series term (left wing sections and odd terms only in symmetric mode).
+     */
+    void calculateBasis( void );
+
     /** */
     void calculateGeometry( void );
 
+    /**
+     * void Wing::clearResultsBlock( Block )
+     * Sets all values of results block to zero (e.g. when block cannot be read from file).
+     * Blocks which arrays are not created are skipped.
+     */
+    void clearResultsBlock( Block block );
+
+    /**
+     * void Wing::createCacheKey( SolutionCache::Key* )
+     * Creates SolutionCache key for the current geometry and parameters.
+     */
+    void createCacheKey( SolutionCache::Key *key );
+
     /**
      * bool Wing::checkIfSectionExists( double )
      * Checks if given Wing Span Y Coordinate already exists in Wing::sections_data.
@@ -350,10 +657,37 @@ private:
      * Creates square matrix Wing::equations_lhs of Fourier series terms' coefficients of order
      * Wing::fourier_accuracy.
      * sin( n * fi ) * ( sin( fi ) + n * mi( fi ) ) * An, where An is uknown variable
-     * and matrix of equations' right hand side mi( fi ) * alpha_0 * sin( fi ), Wing::equations_rhs.
+     * and angle of attack independent parts of equations' right hand side.
+     * In least-squares mode Wing::createLeastSquaresEquations() is used instead.
      */
     void createEquations( void );
 
+    /**
+     * void Wing::createLeastSquaresEquations()
+     * Creates least-squares problem of lifting line equation written for every full span section
+     * except wing tips (in symmetric mode left wing sections only, with plane of symmetry section
+     * half weighted) and reduces it by Householder QR decomposition: Wing::equations_lhs is upper
+     * triangular R factor and Right-Hand-Side parts are Q^T * b, where A and b are equations written
+     * the same way as by Wing::createEquations(). Normal equations are NOT formed, since they square
+     * condition number of the problem.
+     */
+    void createLeastSquaresEquations( void );
+
+    /**
+     * void Wing::createEquationsRHS()
+     * Creates matrix of equations' right hand side mi( fi ) * ( alpha - alpha_0 ) * sin( fi ),
+     * Wing::equations_rhs, for every angle of attack (in least-squares mode linear combination
+     * of Wing::equations_rhs_twist and Wing::equations_rhs_unit).
+     */
+    void createEquationsRHS( void );
+
+    /**
+     * bool Wing::factorizeEquations()
+     * Factorizes equations' Left-Hand-Side into Wing::equations_lu and Wing::equations_piv.
+     * @return TRUE on success, FALSE on failure
+     */
+    bool factorizeEquations( void );
+
     /**
      * void Wing::interpolateCrossSections()
      * Creates arrays of Cross Sections data using linear interpolations of all data:
@@ -370,12 +704,81 @@ private:
      */
     void iterateAoA( void );
 
+    /**
+     * size_t Wing::getResultsBlockSize( Block )
+     * @return number of values in text file results block
+     */
+    size_t getResultsBlockSize( Block block );
+
+    /**
+     * bool Wing::isResultsBlockSaved( Block, int )
+     * @return TRUE if results block is saved to text file with given Wing::SavedResults flags
+     */
+    static bool isResultsBlockSaved( Block block, int flags );
+
+    /**
+     * int Wing::getModes()
+     * @return current compute modes (Wing::Mode flags)
+     */
+    int getModes( void );
+
+    /**
+     * void Wing::setModes( int )
+     * Sets compute modes results read from file were computed in (Wing::Mode flags).
+     */
+    void setModes( int modes );
+
+    /**
+     * void Wing::loadCachedSolution( const SolutionCache::Entry & )
+     * Copies geometry dependent results (interpolated sections, spanwise basis and equations) from cache entry.
+     */
+    void loadCachedSolution( const SolutionCache::Entry &entry );
+
+    /**
+     * void Wing::loadResultsBlocks( int )
+     * Reads or recomputes all results blocks saved with given Wing::SavedResults flags.
+     */
+    void loadResultsBlocks( int flags );
+
+    /**
+     * void Wing::loadResultsBlock( Block )
+     * Reads results block if results are loaded lazily and block has not been read yet,
+     * or recomputes all results if block was not stored in file (all results are zeros
+     * if recomputing fails).
+     */
+    void loadResultsBlock( Block block );
+
+    /**
+     * bool Wing::locateResultsBlock( Block )
+     * Finds results block offset starting from the nearest located block or end of file.
+     * @return TRUE on success, FALSE on failure
+     */
+    bool locateResultsBlock( Block block );
+
+    /**
+     * void Wing::readResultsBlock( TextReader&, Block )
+     * Reads results block from text file at the current position.
+     */
+    void readResultsBlock( TextReader &fs, Block block );
+
+    /**
+     * void Wing::rescaleCharacteristics( double )
+     * Rescales results depending on fluid velocity by ratio of new and old velocity.
+     */
+    void rescaleCharacteristics( double ratio );
+
     /**
      * void Wing::releaseResults()
      * Releases memmory containing computation results this function is called before every new results computations.
      */
     void releaseResults( void );
 
+    /**
+     * void Wing::runParallel( int, const ThreadPool::Job & )
+     * Runs job for range [0, count) using Wing::pool, or in the calling thread if there is no pool.
+     */
+    void runParallel( int count, const ThreadPool::Job &job );
+
     /**
      * void Wing::rewriteSectionsForFullSpan()
      * Rewrties Wing::wingspan, Wing:chord_leng_of_0_liftope, Wing::angle_of_0_lift_deg
@@ -384,26 +787,58 @@ private:
     void rewriteSectionsForFullSpan( void );
 
     /**
-     * bool Wing::solveEquations()
+     * void Wing::solveEquations()
      * Solves system of linear equation due to assign values to equations variables
-     * which are coefficients of Fourier series terms and calculate aerodynamic characteristics
-     * @return TRUE on success, FALSE on failure
+     * which are coefficients of Fourier series terms, using factorized Left-Hand-Side
+     * (and compile-time size specialization if there is one for the system size)
+     */
+    void solveEquations( void );
+
+    /**
+     * void Wing::storeCachedSolution( const SolutionCache::Key & )
+     * Copies geometry dependent results (interpolated sections, spanwise basis and equations) to SolutionCache.
+     */
+    void storeCachedSolution( const SolutionCache::Key &key );
+
+    /**
+     * void Wing::setFileName( const char* )
+     * Sets Wing::file_name (given file may be Wing::file_name itself).
      */
-    bool solveEquations( void );
+    void setFileName( const char* file );
+
+    /**
+     * void Wing::startStage()
+     * Starts measuring duration of computation stage.
+     */
+    void startStage( void );
+
+    /**
+     * void Wing::finishStage( Stage )
+     * Stores duration of computation stage started with Wing::startStage().
+     */
+    void finishStage( Stage stage );
 
     /**
      * void Wing::sortFullSpanSections()
-     * Sorts wingspan, Wing::chord_length, Wing::lift_curve_sl_of_0_liftand Wing::angle_of_0_lift_deg
-     * and Wing::angle_of_0_lift_rad using bubble sort algorithm
+     * Checks if full span arrays are sorted by Wing::wingspan and sorts Wing::wingspan,
+     * Wing::chord_length, Wing::lift_curve_slope, Wing::angle_of_0_lift_deg, Wing::angle_of_0_lift_rad,
+     * Wing::phi and Wing::mu otherwise. Wing::rewriteSectionsForFullSpan() creates them already sorted.
      */
     void sortFullSpanSections( void );
 
     /**
      * void Wing::sortSectionsData()
-     * Sorts unsorted Wing::sections_data[ ] array using bubble sort algorithm.
+     * Sorts unsorted Wing::sections_data[ ] array.
      */
     void sortSectionsData( void );
 
+    /**
+     * void Wing::sortArrays( int, double*[], int )
+     * Sorts arrays_count parallel arrays of count elements by values of the first one.
+     * Stable sort of permutation index is used, so it is O(n log n) in count.
+     */
+    static void sortArrays( int count, double* arrays[], int arrays_count );
+
     /**
      * bool Wing::writeAoAToFile()
      * Writes full span sections arrays to file.
@@ -441,7 +876,8 @@ private:
 
     /**
      * bool Wing::writeWingInputToFile()
-     * Writes Wing::sections_data array to file.
+     * Writes Wing::sections_data array to file. Called after cross sections edits in debug builds only,
+     * so edits do NOT touch file system otherwise.
      */
     bool writeWingInputToFile( void );
 
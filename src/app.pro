@@ -0,0 +1,64 @@
+QT += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TEMPLATE = app
+
+################################################################################
+
+DESTDIR = ../bin
+TARGET = bscaero
+
+################################################################################
+
+include(common.pri)
+
+################################################################################
+
+win32: RC_FILE = bscaero.rc
+
+################################################################################
+
+DEFINES += \
+
+greaterThan(QT_MAJOR_VERSION, 4):win32: DEFINES += USE_QT5
+
+#CONFIG(release, debug|release): DEFINES += QT_NO_DEBUG_OUTPUT
+#DEFINES += QT_NO_DEBUG_OUTPUT
+
+################################################################################
+
+unix: INCLUDEPATH += /usr/include/qwt/
+
+win32: INCLUDEPATH += \
+    $(QWT_ROOT)/include
+
+################################################################################
+
+win32: LIBS += \
+    -L$(QWT_ROOT)/lib
+
+win32: CONFIG(release, debug|release): LIBS += \
+    -lqwt
+
+win32: CONFIG(debug, debug|release): LIBS += \
+    -lqwtd
+
+unix: LIBS += \
+    -L/lib \
+    -L/usr/lib \
+    -lqwt-qt5
+
+include(corelib.pri)
+
+################################################################################
+
+SOURCES += \
+    main.cpp
+
+RESOURCES += \
+    bscaero.qrc
+
+################################################################################
+
+include(gui/gui.pri)
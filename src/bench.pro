@@ -0,0 +1,24 @@
+# BScAero benchmarks (no Qt dependency)
+
+CONFIG -= qt
+CONFIG += console
+
+TEMPLATE = app
+
+################################################################################
+
+DESTDIR = ../bin
+TARGET = bscaero-bench
+
+################################################################################
+
+include(common.pri)
+
+################################################################################
+
+include(corelib.pri)
+
+################################################################################
+
+SOURCES += \
+    $$PWD/bench/main.cpp
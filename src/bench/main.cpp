@@ -0,0 +1,727 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <clocale>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+
+#include <bscaero.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+typedef chrono::steady_clock Clock;
+
+/** Benchmark settings. */
+struct Settings
+{
+    double min_time;    ///< [s] minimum measured time of every benchmark
+    int threads;        ///< number of threads used by Wing::compute() and GaussJordan::factorize()
+    bool quick;         ///< reduced parameters grid
+    string filter;      ///< only benchmarks which names contain this string are run
+    string io_file;     ///< temporary file used by I/O benchmarks
+};
+
+/** Benchmark measurement. */
+struct Measurement
+{
+    long ops;           ///< number of operations measured
+    double time;        ///< [s] total time
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void printUsage( const char *name )
+{
+    cout << BSC_AERO_APP_NAME << " " << BSC_AERO_APP_VER << " benchmarks" << endl;
+    cout << endl;
+    cout << "Usage: " << name << " [options]" << endl;
+    cout << endl;
+    cout << "Measures linear equations solver, every Wing::compute() stage and" << endl;
+    cout << "results files I/O. Reports time per operation and throughput." << endl;
+    cout << endl;
+    cout << "Options:" << endl;
+    cout << "  -f, --filter TEXT    run only benchmarks which names contain TEXT" << endl;
+    cout << "                       (\"solver\", \"stage\", \"compute\", \"recompute\", \"io\")" << endl;
+    cout << "  -m, --min-time SEC   minimum measured time of every benchmark (default: 0.2)" << endl;
+    cout << "  -t, --threads N      number of threads used by Wing::compute() and by" << endl;
+    cout << "                       factorization of large systems (default: 1)" << endl;
+    cout << "      --io-file FILE   temporary file used by I/O benchmarks" << endl;
+    cout << "                       (default: bscaero_bench.tmp)" << endl;
+    cout << "  -q, --quick          reduced parameters grid" << endl;
+    cout << "  -h, --help           print this help" << endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool isSelected( const Settings &settings, const string &name )
+{
+    return settings.filter.empty() || name.find( settings.filter ) != string::npos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Runs operation repeatedly (doubling number of repetitions) until measured
+ * time reaches minimum time. Operation is run once before measurement to
+ * warm up caches. Optional round start function is called before every
+ * measurement round (e.g. to reset values accumulated by operation), so
+ * after return such values cover the returned measurement only.
+ */
+static Measurement measure( const Settings &settings, const function< void(void) > &op,
+                            const function< void(void) > &round_start = nullptr )
+{
+    Measurement m;
+
+    op();
+
+    long reps = 1;
+
+    for ( ;; )
+    {
+        if ( round_start ) round_start();
+
+        Clock::time_point start = Clock::now();
+
+        for ( long r = 0; r < reps; r++ ) op();
+
+        m.ops  = reps;
+        m.time = chrono::duration< double >( Clock::now() - start ).count();
+
+        if ( m.time >= settings.min_time ) break;
+
+        reps *= 2;
+    }
+
+    return m;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void printHeader( const char *title )
+{
+    cout << endl << title << endl;
+    cout << left  << setw( 56 ) << "benchmark"
+         << right << setw( 10 ) << "ops"
+         << right << setw( 16 ) << "ns/op"
+         << right << setw( 16 ) << "throughput"
+         << "  " << "unit" << endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void printResult( const string &name, long ops, double time,
+                         double work_per_op, const char *unit )
+{
+    double ns_per_op = 1.0e9 * time / ops;
+    double throughput = ( time > 0.0 ) ? work_per_op * ops / time : 0.0;
+
+    cout << left  << setw( 56 ) << name
+         << right << setw( 10 ) << ops
+         << right << setw( 16 ) << fixed << setprecision( 1 ) << ns_per_op
+         << right << setw( 16 ) << setprecision( 3 ) << throughput
+         << "  " << unit << endl;
+
+    cout.unsetf( ios_base::floatfield );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Fills well conditioned (diagonally dominant) random system of equations.
+ */
+static void createSystem( int size, vector< double > *mtr, vector< double > *rhs )
+{
+    mt19937 gen( 12345 );
+    uniform_real_distribution< double > dist( -1.0, 1.0 );
+
+    mtr->resize( size * size );
+    rhs->resize( size );
+
+    for ( int r = 0; r < size; r++ )
+    {
+        for ( int c = 0; c < size; c++ )
+        {
+            (*mtr)[ r * size + c ] = dist( gen );
+        }
+
+        (*mtr)[ r * size + r ] += size;
+        (*rhs)[ r ] = dist( gen );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void benchSolver( const Settings &settings )
+{
+    const int sizes_full[]  = { 7, 15, 31, 63, 127, 255, 511, 1023 };
+    const int sizes_quick[] = { 15, 63 };
+
+    const int *sizes = settings.quick ? sizes_quick : sizes_full;
+    const int count  = settings.quick ? 2 : 8;
+
+    // thread pool used by blocked factorization of large systems
+    ThreadPool *pool = ( settings.threads > 1 ) ? new ThreadPool( settings.threads ) : 0;
+
+    // number of right hand side vectors solved at once by substitute
+    const int rhs_count = 64;
+
+    printHeader( "Linear equations solver (throughput: nominal MFLOP/s)" );
+
+    for ( int s = 0; s < count; s++ )
+    {
+        int n = sizes[ s ];
+
+        vector< double > mtr, rhs;
+        createSystem( n, &mtr, &rhs );
+
+        vector< double > x( n );
+        vector< double > lu( n * n );
+        vector< int > piv( n );
+
+        ostringstream name;
+
+        name.str( "" );
+        name << "solver/solve/n=" << n;
+
+        if ( isSelected( settings, name.str() ) )
+        {
+            Measurement m = measure( settings, [&]()
+            {
+                GaussJordan::solve( n, mtr.data(), rhs.data(), x.data() );
+            });
+
+            printResult( name.str(), m.ops, m.time, 1.0e-6 * n * n * n, "MFLOP/s" );
+        }
+
+        name.str( "" );
+        name << "solver/solve/workspace/n=" << n;
+
+        if ( isSelected( settings, name.str() ) )
+        {
+            GaussJordan::Workspace workspace( n );
+
+            Measurement m = measure( settings, [&]()
+            {
+                GaussJordan::solve( n, mtr.data(), rhs.data(), x.data(), workspace );
+            });
+
+            printResult( name.str(), m.ops, m.time, 1.0e-6 * n * n * n, "MFLOP/s" );
+        }
+
+        name.str( "" );
+        name << "solver/factorize/n=" << n;
+
+        if ( isSelected( settings, name.str() ) )
+        {
+            Measurement m = measure( settings, [&]()
+            {
+                lu = mtr;
+                GaussJordan::factorize( n, lu.data(), piv.data(), 1.0e-14, pool );
+            });
+
+            printResult( name.str(), m.ops, m.time, 1.0e-6 * 2.0 * n * n * n / 3.0, "MFLOP/s" );
+        }
+
+        name.str( "" );
+        name << "solver/factorize/fixed/n=" << n;
+
+        if ( GaussJordan::hasFixedSize( n ) && isSelected( settings, name.str() ) )
+        {
+            Measurement m = measure( settings, [&]()
+            {
+                lu = mtr;
+                GaussJordan::factorizeFixed( n, lu.data(), piv.data() );
+            });
+
+            printResult( name.str(), m.ops, m.time, 1.0e-6 * 2.0 * n * n * n / 3.0, "MFLOP/s" );
+        }
+
+        name.str( "" );
+        name << "solver/substitute/n=" << n << "/rhs=" << rhs_count;
+
+        if ( isSelected( settings, name.str() ) )
+        {
+            lu = mtr;
+            GaussJordan::factorize( n, lu.data(), piv.data() );
+
+            vector< double > rhs_block( n * rhs_count );
+            vector< double > x_block( n * rhs_count );
+
+            for ( int i = 0; i < rhs_count; i++ )
+            {
+                for ( int r = 0; r < n; r++ )
+                {
+                    rhs_block[ i * n + r ] = rhs[ r ] * ( i + 1 );
+                }
+            }
+
+            Measurement m = measure( settings, [&]()
+            {
+                GaussJordan::substitute( n, lu.data(), piv.data(), rhs_count,
+                                         rhs_block.data(), x_block.data() );
+            });
+
+            printResult( name.str(), m.ops, m.time, 1.0e-6 * 2.0 * n * n * rhs_count, "MFLOP/s" );
+        }
+
+        name.str( "" );
+        name << "solver/substitute/fixed/n=" << n << "/rhs=" << rhs_count;
+
+        if ( GaussJordan::hasFixedSize( n ) && isSelected( settings, name.str() ) )
+        {
+            lu = mtr;
+            GaussJordan::factorizeFixed( n, lu.data(), piv.data() );
+
+            vector< double > rhs_block( n * rhs_count );
+            vector< double > x_block( n * rhs_count );
+
+            for ( int i = 0; i < rhs_count; i++ )
+            {
+                for ( int r = 0; r < n; r++ )
+                {
+                    rhs_block[ i * n + r ] = rhs[ r ] * ( i + 1 );
+                }
+            }
+
+            Measurement m = measure( settings, [&]()
+            {
+                GaussJordan::substituteFixed( n, lu.data(), piv.data(), rhs_count,
+                                              rhs_block.data(), x_block.data() );
+            });
+
+            printResult( name.str(), m.ops, m.time, 1.0e-6 * 2.0 * n * n * rhs_count, "MFLOP/s" );
+        }
+    }
+
+    delete pool;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Creates tapered wing the same as the one from data/example_01.dat.
+ */
+static bool createWing( Wing *wing, int s_iterations, int f_accuracy, int a_iterations )
+{
+    if ( !wing->addSectionData( 0.0, 0.0 , 1.0 , 6.0, 0.0 ) ) return false;
+    if ( !wing->addSectionData( 5.0, 0.15, 0.75, 6.0, 0.0 ) ) return false;
+
+    double a_start  = -5.0;
+    double a_finish = 15.0;
+
+    // single angle of attack iteration requires start and finish values to be equal
+    if ( a_iterations == 1 ) a_start = a_finish = 5.0;
+
+    return wing->setParameters( a_start, a_finish, a_iterations, 10.0, 1.225, s_iterations, f_accuracy );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void benchCompute( const Settings &settings )
+{
+    const int s_full[]  = { 25, 50, 100, 200, 400 };
+    const int s_quick[] = { 25, 100 };
+    const int f_full[]  = { 5, 10, 20, 40 };
+    const int f_quick[] = { 10 };
+    const int a_full[]  = { 1, 21, 201 };
+    const int a_quick[] = { 21 };
+
+    const int *s_grid = settings.quick ? s_quick : s_full;
+    const int *f_grid = settings.quick ? f_quick : f_full;
+    const int *a_grid = settings.quick ? a_quick : a_full;
+
+    const int s_count = settings.quick ? 2 : 5;
+    const int f_count = settings.quick ? 1 : 4;
+    const int a_count = settings.quick ? 1 : 3;
+
+    printHeader( "Wing::compute() (throughput: angles of attack per second)" );
+
+    // all stages are measured, so geometry dependent results must not be cached
+    size_t cache_capacity = SolutionCache::instance()->getCapacity();
+    SolutionCache::instance()->setCapacity( 0 );
+
+    for ( int is = 0; is < s_count; is++ )
+    {
+        for ( int jf = 0; jf < f_count; jf++ )
+        {
+            for ( int ka = 0; ka < a_count; ka++ )
+            {
+                int s = s_grid[ is ];
+                int f = f_grid[ jf ];
+                int a = a_grid[ ka ];
+
+                // Fourier Series Accuracy must be smaller than Number of Cross Sections
+                if ( f >= s ) continue;
+
+                ostringstream params;
+                params << "s=" << s << "/f=" << f << "/a=" << a;
+
+                bool compute_selected = isSelected( settings, "compute/" + params.str() );
+                bool stages_selected = false;
+
+                for ( int st = 0; st < Wing::StagesCount; st++ )
+                {
+                    string stage_name = Wing::getStageName( (Wing::Stage)st );
+                    stages_selected = stages_selected
+                            || isSelected( settings, "stage/" + stage_name + "/" + params.str() );
+                }
+
+                if ( !compute_selected && !stages_selected ) continue;
+
+                Wing wing;
+
+                wing.setThreads( settings.threads );
+
+                if ( !createWing( &wing, s, f, a ) )
+                {
+                    cerr << "Error: cannot create wing for " << params.str() << endl;
+                    continue;
+                }
+
+                // stages times are accumulated over repetitions of the last measurement round
+                double stage_time[ Wing::StagesCount ] = { 0.0 };
+                bool computed = true;
+
+                Measurement m = measure( settings, [&]()
+                {
+                    // all stages are redone every time
+                    wing.invalidate();
+                    computed = wing.compute() && computed;
+
+                    for ( int st = 0; st < Wing::StagesCount; st++ )
+                    {
+                        stage_time[ st ] += wing.getStageTime( (Wing::Stage)st );
+                    }
+                },
+                [&]()
+                {
+                    for ( int st = 0; st < Wing::StagesCount; st++ ) stage_time[ st ] = 0.0;
+                });
+
+                if ( !computed )
+                {
+                    cerr << "Error: computations failed for " << params.str() << endl;
+                    continue;
+                }
+
+                if ( compute_selected )
+                {
+                    printResult( "compute/" + params.str(), m.ops, m.time, a, "AoA/s" );
+                }
+
+                for ( int st = 0; st < Wing::StagesCount; st++ )
+                {
+                    string name = string( "stage/" ) + Wing::getStageName( (Wing::Stage)st ) + "/" + params.str();
+
+                    if ( isSelected( settings, name ) )
+                    {
+                        printResult( name, m.ops, stage_time[ st ], a, "AoA/s" );
+                    }
+                }
+            }
+        }
+    }
+
+    SolutionCache::instance()->setCapacity( cache_capacity );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void benchRecompute( const Settings &settings )
+{
+    const int s_full[]  = { 100, 400 };
+    const int s_quick[] = { 100 };
+    const int a_full[]  = { 21, 201 };
+    const int a_quick[] = { 21 };
+
+    const int *s_grid = settings.quick ? s_quick : s_full;
+    const int *a_grid = settings.quick ? a_quick : a_full;
+
+    const int count = settings.quick ? 1 : 2;
+
+    printHeader( "Wing::compute() after parameters change (throughput: angles of attack per second)" );
+
+    for ( int is = 0; is < count; is++ )
+    {
+        for ( int ka = 0; ka < count; ka++ )
+        {
+            int s = s_grid[ is ];
+            int f = 20;
+            int a = a_grid[ ka ];
+
+            ostringstream params;
+            params << "s=" << s << "/f=" << f << "/a=" << a;
+
+            // parameters are switched between two values, so every computation is incremental,
+            // or new wing with the same geometry is computed using cached geometry dependent results
+            const char *names[] = { "recompute/aoa/", "recompute/velocity/", "recompute/cached/" };
+
+            for ( int n = 0; n < 3; n++ )
+            {
+                string name = names[ n ] + params.str();
+
+                if ( !isSelected( settings, name ) ) continue;
+
+                Wing wing;
+
+                wing.setThreads( settings.threads );
+
+                if ( !createWing( &wing, s, f, a ) || !wing.compute() )
+                {
+                    cerr << "Error: cannot compute wing for " << params.str() << endl;
+                    continue;
+                }
+
+                bool computed = true;
+                long toggle = 0;
+
+                Measurement m = measure( settings, [&]()
+                {
+                    double change = ( toggle++ % 2 ) ? 1.0 : 0.0;
+
+                    if ( n == 0 )
+                    {
+                        wing.setParameters( -5.0 + change, 15.0, a, 10.0, 1.225, s, f );
+                        computed = wing.compute() && computed;
+                    }
+                    else if ( n == 1 )
+                    {
+                        wing.setParameters( -5.0, 15.0, a, 10.0 + change, 1.225, s, f );
+                        computed = wing.compute() && computed;
+                    }
+                    else
+                    {
+                        Wing other;
+                        other.setThreads( settings.threads );
+                        computed = createWing( &other, s, f, a ) && other.compute() && computed;
+                    }
+                });
+
+                if ( !computed )
+                {
+                    cerr << "Error: computations failed for " << params.str() << endl;
+                    continue;
+                }
+
+                printResult( name, m.ops, m.time, a, "AoA/s" );
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static long getFileSize( const char *file )
+{
+    FILE *fp = fopen( file, "rb" );
+
+    if ( !fp ) return 0;
+
+    fseek( fp, 0, SEEK_END );
+    long size = ftell( fp );
+    fclose( fp );
+
+    return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void benchIO( const Settings &settings )
+{
+    const int s_full[]  = { 50, 200, 400 };
+    const int s_quick[] = { 100 };
+    const int a_full[]  = { 21, 201, 1001 };
+    const int a_quick[] = { 101 };
+
+    const int *s_grid = settings.quick ? s_quick : s_full;
+    const int *a_grid = settings.quick ? a_quick : a_full;
+
+    const int count = settings.quick ? 1 : 3;
+
+    const char *file = settings.io_file.c_str();
+
+    printHeader( "Results files I/O (throughput: MB/s)" );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        int s = s_grid[ i ];
+        int a = a_grid[ i ];
+        int f = 20;
+
+        ostringstream params;
+        params << "s=" << s << "/f=" << f << "/a=" << a;
+
+        const char *names[] = { "io/writeToFile/", "io/readFromFile/", "io/writeToBinaryFile/", "io/readFromBinaryFile/" };
+        bool selected = false;
+
+        for ( int n = 0; n < 4; n++ )
+        {
+            selected = selected || isSelected( settings, names[ n ] + params.str() );
+        }
+
+        if ( !selected ) continue;
+
+        Wing wing;
+
+        wing.setThreads( settings.threads );
+
+        if ( !createWing( &wing, s, f, a ) || !wing.compute() )
+        {
+            cerr << "Error: computations failed for " << params.str() << endl;
+            continue;
+        }
+
+        // text and binary formats
+        for ( int binary = 0; binary < 2; binary++ )
+        {
+            string write_name = ( binary ? "io/writeToBinaryFile/"  : "io/writeToFile/"  ) + params.str();
+            string read_name  = ( binary ? "io/readFromBinaryFile/" : "io/readFromFile/" ) + params.str();
+
+            if ( !isSelected( settings, write_name ) && !isSelected( settings, read_name ) ) continue;
+
+            bool success = true;
+
+            Measurement m_write = measure( settings, [&]()
+            {
+                if ( binary )
+                    success = wing.writeToBinaryFile( file ) && success;
+                else
+                    success = wing.writeToFile( file ) && success;
+            });
+
+            if ( !success )
+            {
+                cerr << "Error: cannot write file " << file << endl;
+                continue;
+            }
+
+            double size_mb = 1.0e-6 * getFileSize( file );
+
+            if ( isSelected( settings, write_name ) )
+            {
+                printResult( write_name, m_write.ops, m_write.time, size_mb, "MB/s" );
+            }
+
+            if ( isSelected( settings, read_name ) )
+            {
+                Measurement m_read = measure( settings, [&]()
+                {
+                    Wing wing_read;
+
+                    if ( binary )
+                        success = wing_read.readFromBinaryFile( file ) && success;
+                    else
+                        success = wing_read.readFromFile( file ) && success;
+                });
+
+                if ( !success )
+                {
+                    cerr << "Error: cannot read file " << file << endl;
+                }
+                else
+                {
+                    printResult( read_name, m_read.ops, m_read.time, size_mb, "MB/s" );
+                }
+            }
+
+            remove( file );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int main( int argc, char *argv[] )
+{
+    setlocale( LC_ALL, "C" );
+
+    Settings settings;
+
+    settings.min_time = 0.2;
+    settings.threads  = 1;
+    settings.quick    = false;
+    settings.io_file  = "bscaero_bench.tmp";
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        string arg = argv[ i ];
+        bool has_value = ( i + 1 < argc );
+
+        if ( arg == "-h" || arg == "--help" )
+        {
+            printUsage( argv[ 0 ] );
+            return 0;
+        }
+        else if ( ( arg == "-f" || arg == "--filter" ) && has_value )
+        {
+            settings.filter = argv[ ++i ];
+        }
+        else if ( ( arg == "-m" || arg == "--min-time" ) && has_value )
+        {
+            settings.min_time = atof( argv[ ++i ] );
+        }
+        else if ( ( arg == "-t" || arg == "--threads" ) && has_value )
+        {
+            settings.threads = atoi( argv[ ++i ] );
+        }
+        else if ( arg == "--io-file" && has_value )
+        {
+            settings.io_file = argv[ ++i ];
+        }
+        else if ( arg == "-q" || arg == "--quick" )
+        {
+            settings.quick = true;
+        }
+        else
+        {
+            cerr << "Error: unknown option " << arg << endl;
+            printUsage( argv[ 0 ] );
+            return 1;
+        }
+    }
+
+    cout << BSC_AERO_APP_NAME << " " << BSC_AERO_APP_VER << " benchmarks" << endl;
+    cout << "minimum time: " << settings.min_time << " s, threads: " << settings.threads
+         << ", solver kernel: " << GaussJordan::getKernelName() << endl;
+
+    benchSolver( settings );
+    benchCompute( settings );
+    benchRecompute( settings );
+    benchIO( settings );
+
+    return 0;
+}
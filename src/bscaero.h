@@ -0,0 +1,54 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BSCAERO_H
+#define BSCAERO_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file bscaero.h
+ * @brief BScAero computational core library public header.
+ *
+ * Applications linking against the core library (libbscaero) should include
+ * only this header. It does not depend on Qt.
+ *
+ * Example:
+ * @code
+ * Wing wing;
+ * if ( wing.readFromFile( "wing.dat" ) && wing.compute() )
+ * {
+ *     double cl = wing.getLiftCoef( 0 );
+ * }
+ * @endcode
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <defs.h>
+
+#include <GaussJordan.h>
+#include <SolutionCache.h>
+#include <Wing.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BSCAERO_H
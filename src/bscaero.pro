@@ -1,92 +1,24 @@
-QT += core gui
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-TEMPLATE = app
-
-################################################################################
-
-DESTDIR = ../bin
-TARGET = bscaero
-
-################################################################################
-
-CONFIG += c++11
-
-################################################################################
-
-win32: RC_FILE = bscaero.rc
+TEMPLATE = subdirs
 
 ################################################################################
 
-win32: CONFIG(release, debug|release): QMAKE_CXXFLAGS += -O2
-unix:  CONFIG(release, debug|release): QMAKE_CXXFLAGS += -O3
-
-#win32: QMAKE_CXXFLAGS += /Zc:wchar_t
-
-win32: QMAKE_LFLAGS += /INCREMENTAL:NO
-
-################################################################################
-
-DEFINES += \
-
-greaterThan(QT_MAJOR_VERSION, 4):win32: DEFINES += USE_QT5
-
-win32: DEFINES += \
-    WIN32 \
-    _WINDOWS \
-    _CRT_SECURE_NO_DEPRECATE \
-    _SCL_SECURE_NO_WARNINGS \
-    _USE_MATH_DEFINES
+SUBDIRS += \
+    core \
+    app \
+    cli \
+    bench \
+    tests
 
-win32: CONFIG(release, debug|release): DEFINES += NDEBUG
-win32: CONFIG(debug, debug|release):   DEFINES += _DEBUG
+core.file = core.pro
 
-#CONFIG(release, debug|release): DEFINES += QT_NO_DEBUG_OUTPUT
-#DEFINES += QT_NO_DEBUG_OUTPUT
+app.file = app.pro
+app.depends = core
 
-unix: DEFINES += _LINUX_
+cli.file = cli.pro
+cli.depends = core
 
-################################################################################
-
-INCLUDEPATH += ./
-
-unix: INCLUDEPATH += /usr/include/qwt/
-
-win32: INCLUDEPATH += \
-    $(QWT_ROOT)/include
-
-################################################################################
-
-win32: LIBS += \
-    -L$(QWT_ROOT)/lib
-
-win32: CONFIG(release, debug|release): LIBS += \
-    -lqwt
-
-win32: CONFIG(debug, debug|release): LIBS += \
-    -lqwtd
-
-unix: LIBS += \
-    -L/lib \
-    -L/usr/lib \
-    -lqwt-qt5
-
-################################################################################
-
-HEADERS += \
-    defs.h \
-    $$PWD/GaussJordan.h \
-    $$PWD/Wing.h
-
-SOURCES += \
-    main.cpp \
-    $$PWD/GaussJordan.cpp \
-    $$PWD/Wing.cpp
-
-RESOURCES += \
-    bscaero.qrc
-
-################################################################################
+bench.file = bench.pro
+bench.depends = core
 
-include(gui/gui.pri)
+tests.file = tests.pro
+tests.depends = core
@@ -0,0 +1,24 @@
+# BScAero command-line batch runner (no Qt dependency)
+
+CONFIG -= qt
+CONFIG += console
+
+TEMPLATE = app
+
+################################################################################
+
+DESTDIR = ../bin
+TARGET = bscaero-cli
+
+################################################################################
+
+include(common.pri)
+
+################################################################################
+
+include(corelib.pri)
+
+################################################################################
+
+SOURCES += \
+    $$PWD/cli/main.cpp
@@ -0,0 +1,380 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <clocale>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdlib.h>
+
+#include <bscaero.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Job
+{
+    string input;       ///< input file path
+    string output;      ///< output file path
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void printUsage( const char *name )
+{
+    cout << BSC_AERO_APP_NAME << " " << BSC_AERO_APP_VER << " batch runner" << endl;
+    cout << endl;
+    cout << "Usage: " << name << " [options] [file.dat ...]" << endl;
+    cout << endl;
+    cout << "Reads wing geometry and computation parameters from every input file," << endl;
+    cout << "computes aerodynamic characteristics and writes results file." << endl;
+    cout << endl;
+    cout << "Options:" << endl;
+    cout << "  -m, --manifest FILE  read input files paths from FILE (one per line)" << endl;
+    cout << "  -o, --output DIR     write results to DIR (default: next to input file" << endl;
+    cout << "                       with \"_results\" appended to the file name)" << endl;
+    cout << "  -j, --jobs N         number of files processed concurrently" << endl;
+    cout << "                       (default: number of CPU cores)" << endl;
+    cout << "  -t, --threads N      number of threads used by single computation (default: 1)" << endl;
+    cout << "  -b, --binary         write results in binary format (\".bsc\" extension)" << endl;
+    cout << "  -s, --save LIST      results saved to text files, comma separated list of:" << endl;
+    cout << "                       polar, gamma, lift, velocity, drag, equations, all" << endl;
+    cout << "                       (default: all, angles of attack are always saved)" << endl;
+    cout << "      --timing         write computation stages durations to JSON file" << endl;
+    cout << "                       (results file name with \".timing.json\" appended)" << endl;
+    cout << "  -h, --help           print this help" << endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static string getOutputPath( const string &input, const string &output_dir )
+{
+    size_t slash = input.find_last_of( "/\\" );
+    string base = ( slash == string::npos ) ? input : input.substr( slash + 1 );
+
+    if ( output_dir.empty() )
+    {
+        string dir = ( slash == string::npos ) ? "" : input.substr( 0, slash + 1 );
+        size_t dot = base.find_last_of( '.' );
+
+        if ( dot == string::npos )
+            return dir + base + "_results";
+        else
+            return dir + base.substr( 0, dot ) + "_results" + base.substr( dot );
+    }
+
+    return output_dir + "/" + base;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static string getBinaryPath( const string &output )
+{
+    size_t slash = output.find_last_of( "/\\" );
+    size_t dot = output.find_last_of( '.' );
+
+    if ( dot == string::npos || ( slash != string::npos && dot < slash ) )
+        return output + ".bsc";
+    else
+        return output.substr( 0, dot ) + ".bsc";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static int parseSavedResults( const string &list )
+{
+    int flags = 0;
+    size_t first = 0;
+
+    while ( first <= list.size() )
+    {
+        size_t last = list.find( ',', first );
+        if ( last == string::npos ) last = list.size();
+
+        string name = list.substr( first, last - first );
+
+        if      ( name == "polar"     ) flags |= Wing::SavedPolar;
+        else if ( name == "gamma"     ) flags |= Wing::SavedGamma;
+        else if ( name == "lift"      ) flags |= Wing::SavedLiftCoefDist;
+        else if ( name == "velocity"  ) flags |= Wing::SavedVelocityDist;
+        else if ( name == "drag"      ) flags |= Wing::SavedDragCoefDist;
+        else if ( name == "equations" ) flags |= Wing::SavedIntermediates;
+        else if ( name == "all"       ) flags |= Wing::SavedAll;
+        else return -1;
+
+        first = last + 1;
+    }
+
+    return flags;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool readManifest( const char *file, vector< string > *inputs )
+{
+    ifstream fs( file );
+
+    if ( !fs.is_open() ) return false;
+
+    string line;
+
+    while ( getline( fs, line ) )
+    {
+        // trimming whitespaces
+        size_t first = line.find_first_not_of( " \t\r" );
+        size_t last  = line.find_last_not_of( " \t\r" );
+
+        if ( first == string::npos ) continue;
+
+        line = line.substr( first, last - first + 1 );
+
+        // skipping comments
+        if ( line[ 0 ] == '#' ) continue;
+
+        inputs->push_back( line );
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool runJob( const Job &job, int threads, bool binary, int saved, bool timing, string *error )
+{
+    Wing wing;
+
+    wing.setThreads( threads );
+    wing.setSavedResults( saved );
+
+    if ( !wing.readFromFile( job.input.c_str() ) )
+    {
+        *error = wing.getFileError();
+        return false;
+    }
+
+    if ( !wing.compute() )
+    {
+        *error = "computations failed";
+        return false;
+    }
+
+    bool written = binary ? wing.writeToBinaryFile( job.output.c_str() )
+                          : wing.writeToFile( job.output.c_str() );
+
+    if ( !written )
+    {
+        *error = "cannot write results file " + job.output;
+        return false;
+    }
+
+    if ( timing && !wing.writeTimingToFile( ( job.output + ".timing.json" ).c_str() ) )
+    {
+        *error = "cannot write timing file " + job.output + ".timing.json";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int main( int argc, char *argv[] )
+{
+    setlocale( LC_ALL, "C" );
+
+    vector< string > inputs;
+    string output_dir;
+    int jobs = (int)thread::hardware_concurrency();
+    int threads = 1;
+    bool binary = false;
+    int saved = Wing::SavedAll;
+    bool timing = false;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        string arg = argv[ i ];
+        bool has_value = ( i + 1 < argc );
+
+        if ( arg == "-h" || arg == "--help" )
+        {
+            printUsage( argv[ 0 ] );
+            return 0;
+        }
+        else if ( ( arg == "-m" || arg == "--manifest" ) && has_value )
+        {
+            if ( !readManifest( argv[ ++i ], &inputs ) )
+            {
+                cerr << "Error: cannot read manifest file " << argv[ i ] << endl;
+                return 1;
+            }
+        }
+        else if ( ( arg == "-o" || arg == "--output" ) && has_value )
+        {
+            output_dir = argv[ ++i ];
+        }
+        else if ( ( arg == "-j" || arg == "--jobs" ) && has_value )
+        {
+            jobs = atoi( argv[ ++i ] );
+        }
+        else if ( ( arg == "-t" || arg == "--threads" ) && has_value )
+        {
+            threads = atoi( argv[ ++i ] );
+        }
+        else if ( arg == "-b" || arg == "--binary" )
+        {
+            binary = true;
+        }
+        else if ( ( arg == "-s" || arg == "--save" ) && has_value )
+        {
+            saved = parseSavedResults( argv[ ++i ] );
+
+            if ( saved < 0 )
+            {
+                cerr << "Error: invalid saved results list " << argv[ i ] << endl;
+                return 1;
+            }
+        }
+        else if ( arg == "--timing" )
+        {
+            timing = true;
+        }
+        else if ( arg.size() > 1 && arg[ 0 ] == '-' )
+        {
+            cerr << "Error: unknown option " << arg << endl;
+            printUsage( argv[ 0 ] );
+            return 1;
+        }
+        else
+        {
+            inputs.push_back( arg );
+        }
+    }
+
+    if ( inputs.empty() )
+    {
+        printUsage( argv[ 0 ] );
+        return 1;
+    }
+
+    vector< Job > job_list( inputs.size() );
+
+    for ( size_t i = 0; i < inputs.size(); i++ )
+    {
+        job_list[ i ].input  = inputs[ i ];
+        job_list[ i ].output = getOutputPath( inputs[ i ], output_dir );
+
+        if ( binary ) job_list[ i ].output = getBinaryPath( job_list[ i ].output );
+    }
+
+    // concurrent jobs must not write the same results file
+    // (e.g. input files with the same name from different directories)
+    map< string, string > outputs;
+
+    for ( size_t i = 0; i < job_list.size(); i++ )
+    {
+        pair< map< string, string >::iterator, bool > result =
+                outputs.insert( make_pair( job_list[ i ].output, job_list[ i ].input ) );
+
+        if ( !result.second )
+        {
+            cerr << "Error: input files " << result.first->second << " and " << job_list[ i ].input
+                 << " have the same results file " << job_list[ i ].output << endl;
+            return 1;
+        }
+    }
+
+    if ( jobs < 1 ) jobs = 1;
+    if ( jobs > (int)job_list.size() ) jobs = (int)job_list.size();
+
+    // workers take next job as soon as previous one is finished
+    atomic< int > next_job( 0 );
+    atomic< int > failed( 0 );
+    mutex output_mutex;
+
+    auto worker = [ & ]()
+    {
+        int j;
+
+        while ( ( j = next_job++ ) < (int)job_list.size() )
+        {
+            string error;
+            bool success = false;
+
+            // exception escaping worker thread would terminate all concurrent jobs,
+            // so it fails the job only (e.g. out of memory for large sweeps)
+            try
+            {
+                success = runJob( job_list[ j ], threads, binary, saved, timing, &error );
+            }
+            catch ( const exception &e )
+            {
+                error = e.what();
+            }
+            catch ( ... )
+            {
+                error = "unknown exception";
+            }
+
+            lock_guard< mutex > lock( output_mutex );
+
+            if ( success )
+            {
+                cout << "[done] " << job_list[ j ].input << " -> " << job_list[ j ].output << endl;
+            }
+            else
+            {
+                cerr << "[failed] " << job_list[ j ].input << ": " << error << endl;
+                failed++;
+            }
+        }
+    };
+
+    vector< thread > workers;
+
+    for ( int i = 1; i < jobs; i++ )
+    {
+        workers.push_back( thread( worker ) );
+    }
+
+    worker();
+
+    for ( size_t i = 0; i < workers.size(); i++ )
+    {
+        workers[ i ].join();
+    }
+
+    cout << ( job_list.size() - failed ) << " of " << job_list.size() << " files processed successfully." << endl;
+
+    return ( failed > 0 ) ? 1 : 0;
+}
@@ -0,0 +1,28 @@
+CONFIG += c++17
+
+################################################################################
+
+win32: CONFIG(release, debug|release): QMAKE_CXXFLAGS += -O2
+unix:  CONFIG(release, debug|release): QMAKE_CXXFLAGS += -O3
+
+#win32: QMAKE_CXXFLAGS += /Zc:wchar_t
+
+win32: QMAKE_LFLAGS += /INCREMENTAL:NO
+
+################################################################################
+
+win32: DEFINES += \
+    WIN32 \
+    _WINDOWS \
+    _CRT_SECURE_NO_DEPRECATE \
+    _SCL_SECURE_NO_WARNINGS \
+    _USE_MATH_DEFINES
+
+win32: CONFIG(release, debug|release): DEFINES += NDEBUG
+win32: CONFIG(debug, debug|release):   DEFINES += _DEBUG
+
+unix: DEFINES += _LINUX_
+
+################################################################################
+
+INCLUDEPATH += $$PWD
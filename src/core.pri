@@ -0,0 +1,25 @@
+HEADERS += \
+    $$PWD/bscaero.h \
+    $$PWD/BinaryFile.h \
+    $$PWD/defs.h \
+    $$PWD/GaussJordan.h \
+    $$PWD/MappedFile.h \
+    $$PWD/Matrix.h \
+    $$PWD/Results.h \
+    $$PWD/SolutionCache.h \
+    $$PWD/TextReader.h \
+    $$PWD/TextWriter.h \
+    $$PWD/ThreadPool.h \
+    $$PWD/Wing.h
+
+SOURCES += \
+    $$PWD/BinaryFile.cpp \
+    $$PWD/GaussJordan.cpp \
+    $$PWD/MappedFile.cpp \
+    $$PWD/Matrix.cpp \
+    $$PWD/Results.cpp \
+    $$PWD/SolutionCache.cpp \
+    $$PWD/TextReader.cpp \
+    $$PWD/TextWriter.cpp \
+    $$PWD/ThreadPool.cpp \
+    $$PWD/Wing.cpp
@@ -0,0 +1,25 @@
+# BScAero computational core library (no Qt dependency)
+# static library by default, use "CONFIG+=bscaero_shared" to build shared one
+
+CONFIG -= qt
+
+TEMPLATE = lib
+
+!bscaero_shared: CONFIG += staticlib
+
+################################################################################
+
+DESTDIR = ../lib
+TARGET = bscaero
+
+################################################################################
+
+include(common.pri)
+
+################################################################################
+
+unix: LIBS += -lpthread
+
+################################################################################
+
+include(core.pri)
@@ -0,0 +1,11 @@
+# linking against BScAero computational core library
+# (to be included by projects placed in the same directory as core.pro)
+
+LIBS += -L$$OUT_PWD/../lib -lbscaero
+
+unix: LIBS += -lpthread
+
+!bscaero_shared {
+    win32: PRE_TARGETDEPS += $$OUT_PWD/../lib/bscaero.lib
+    unix:  PRE_TARGETDEPS += $$OUT_PWD/../lib/libbscaero.a
+}
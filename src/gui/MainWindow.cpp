@@ -116,7 +116,9 @@ void MainWindow::fileOpen()
     QString filter;
     QString selectedFilter;
 
-    filter += selectedFilter = "DAT (*.dat)";
+    filter += selectedFilter = "BScAero files (*.dat *.bsc)";
+    filter += ";;DAT (*.dat)";
+    filter += ";;BSC binary (*.bsc)";
 
     QString file = QFileDialog::getOpenFileName( this, caption, dir, filter, &selectedFilter );
 
@@ -150,6 +152,10 @@ void MainWindow::fileOpen()
 
             if ( _wing->isResultsUpToDate() ) showResults();
         }
+        else
+        {
+            QMessageBox::warning( this, BSC_AERO_APP_NAME, _wing->getFileError() );
+        }
     }
 }
 
@@ -173,7 +179,7 @@ void MainWindow::fileSave()
 {
     if ( _fileName.length() > 0 )
     {
-        if ( _wing->writeToFile( _fileName.toStdString().c_str() ) )
+        if ( fileWrite( _fileName ) )
         {
             _file_changed = false;
             updateAll();
@@ -195,6 +201,7 @@ void MainWindow::fileSaveAs()
     QString selectedFilter;
 
     filter += selectedFilter = "DAT (*.dat)";
+    filter += ";;BSC binary (*.bsc)";
 
     QString newFile = QFileDialog::getSaveFileName( this, caption, dir, filter, &selectedFilter );
 
@@ -202,7 +209,7 @@ void MainWindow::fileSaveAs()
     {
         _fileName = newFile;
 
-        if ( _wing->writeToFile( _fileName.toStdString().c_str() ) )
+        if ( fileWrite( _fileName ) )
         {
             _file_changed = false;
             updateAll();
@@ -212,6 +219,17 @@ void MainWindow::fileSaveAs()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool MainWindow::fileWrite( const QString &file )
+{
+    // file format is selected by file extension
+    if ( QFileInfo( file ).suffix().toLower() == "bsc" )
+        return _wing->writeToBinaryFile( file.toStdString().c_str() );
+    else
+        return _wing->writeToFile( file.toStdString().c_str() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void MainWindow::sectionInsert()
 {
     if ( !_wing ) _wing = new Wing();
@@ -670,17 +688,20 @@ void MainWindow::on_spinBoxFourierAccuracy_valueChanged( int /*arg1*/ )
 
 void MainWindow::on_pushButtonCompute_clicked()
 {
-    QTime time;
-
-    time.start();
-    std::cout << "[" << time.toString( "hh:mm:ss.zzz" ).toStdString() << "] Computations started..." << std::endl;
+    std::cout << "[" << QTime::currentTime().toString( "hh:mm:ss.zzz" ).toStdString() << "] Computations started..." << std::endl;
 
     bool success = _wing->compute();
 
     if ( success )
     {
-        time.start();
-        std::cout << "[" << time.toString( "hh:mm:ss.zzz" ).toStdString() << "] Computations finished." << std::endl;
+        std::cout << "[" << QTime::currentTime().toString( "hh:mm:ss.zzz" ).toStdString() << "] Computations finished in "
+                  << _wing->getComputeTime() * 1000.0 << " ms." << std::endl;
+
+        for ( int i = 0; i < Wing::StagesCount; i++ )
+        {
+            Wing::Stage stage = (Wing::Stage)i;
+            std::cout << "    " << Wing::getStageName( stage ) << ": " << _wing->getStageTime( stage ) * 1000.0 << " ms" << std::endl;
+        }
 
         _file_changed = true;
 
@@ -690,7 +711,6 @@ void MainWindow::on_pushButtonCompute_clicked()
     }
     else
     {
-        time.start();
-        std::cout << "[" << time.toString( "hh:mm:ss.zzz" ).toStdString() << "] Computations stopped. Error on Wing::computeCharacteristics()." << std::endl;
+        std::cout << "[" << QTime::currentTime().toString( "hh:mm:ss.zzz" ).toStdString() << "] Computations stopped. Error on Wing::computeCharacteristics()." << std::endl;
     }
 }
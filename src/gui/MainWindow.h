@@ -76,6 +76,7 @@ private:
     void fileNew();
     void fileSave();
     void fileSaveAs();
+    bool fileWrite( const QString &file );
 
     void sectionInsert();
     void sectionEdit();
@@ -0,0 +1,24 @@
+# BScAero tests (no Qt dependency)
+
+CONFIG -= qt
+CONFIG += console
+
+TEMPLATE = app
+
+################################################################################
+
+DESTDIR = ../bin
+TARGET = bscaero-tests
+
+################################################################################
+
+include(common.pri)
+
+################################################################################
+
+include(corelib.pri)
+
+################################################################################
+
+SOURCES += \
+    $$PWD/tests/main.cpp
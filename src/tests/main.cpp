@@ -0,0 +1,1257 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <clocale>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <bscaero.h>
+#include <BinaryFile.h>
+#include <ThreadPool.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+typedef bool (*TestFunction)( string *error );
+
+/** Test case. */
+struct Test
+{
+    const char *name;       ///< test name
+    TestFunction run;       ///< test function
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Creates tapered wing the same as the one from data/example_01.dat.
+ */
+static bool createWing( Wing *wing )
+{
+    if ( !wing->addSectionData( 0.0, 0.0 , 1.0 , 6.0, 0.0 ) ) return false;
+    if ( !wing->addSectionData( 5.0, 0.15, 0.75, 6.0, 0.0 ) ) return false;
+
+    return wing->setParameters( -5.0, 15.0, 21, 10.0, 1.225, 50, 8 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Returns true if values differ by no more than tolerance relative to the
+ * greater of the value magnitude and 1 (NaN values are never equal).
+ */
+static bool isEqual( double value_1, double value_2, double tolerance )
+{
+    return fabs( value_1 - value_2 ) <= tolerance * max( 1.0, fabs( value_2 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Returns true if results of both wings are the same (bit-identical by default).
+ */
+static bool compareResults( Wing *wing_1, Wing *wing_2, double tolerance = 0.0 )
+{
+    if ( wing_1->getAoA_Iterations()   != wing_2->getAoA_Iterations()   ) return false;
+    if ( wing_1->getSectionsFullspan() != wing_2->getSectionsFullspan() ) return false;
+
+    for ( int a = 0; a < wing_1->getAoA_Iterations(); a++ )
+    {
+        if ( !isEqual( wing_1->getLiftCoef( a ), wing_2->getLiftCoef( a ), tolerance ) ) return false;
+        if ( !isEqual( wing_1->getDragCoef( a ), wing_2->getDragCoef( a ), tolerance ) ) return false;
+
+        for ( int i = 0; i < wing_1->getSectionsFullspan(); i++ )
+        {
+            if ( !isEqual( wing_1->getGamma( a, i ), wing_2->getGamma( a, i ), tolerance ) ) return false;
+            if ( !isEqual( wing_1->getDragCoefDist( a, i ), wing_2->getDragCoefDist( a, i ), tolerance ) ) return false;
+        }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Sets process-wide solution cache capacity for the object lifetime, so
+ * wings compared against each other are computed from scratch (capacity 0)
+ * regardless of other tests.
+ */
+class CacheCapacity
+{
+public:
+
+    explicit CacheCapacity( size_t capacity ) :
+        _capacity ( SolutionCache::instance()->getCapacity() )
+    {
+        SolutionCache::instance()->setCapacity( capacity );
+    }
+
+    ~CacheCapacity()
+    {
+        SolutionCache::instance()->setCapacity( _capacity );
+    }
+
+private:
+
+    size_t _capacity;   ///< previous capacity
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void writeTextFile( const char *file, const char *content )
+{
+    ofstream fs( file, ios_base::binary | ios_base::trunc );
+    fs << content;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Reads invalid cross sections CSV file and checks if it is rejected with
+ * error naming the offending line.
+ */
+static bool checkInvalidCSV( const char *content, const char *line, string *error )
+{
+    const char *file = "bscaero_test.csv";
+
+    writeTextFile( file, content );
+
+    Wing wing;
+
+    bool success = wing.readSectionsFromCSV( file );
+
+    remove( file );
+
+    if ( success || wing.getSections() != 0 )
+    {
+        *error = "invalid file has been read";
+        return false;
+    }
+
+    if ( string( wing.getFileError() ).find( line ) == string::npos )
+    {
+        *error = string( "error does not name line " ) + line + ": " + wing.getFileError();
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Cross sections are read from CSV file with header row, empty lines,
+ * whitespaces around fields and rows in any order.
+ */
+static bool testCSVValid( string *error )
+{
+    const char *file = "bscaero_test.csv";
+
+    writeTextFile( file, "y, le_x, te_x, slope, angle\r\n"
+                         "5.0, 0.15, 0.75, 6.0, -1.0\r\n"
+                         "\r\n"
+                         " 0.0 ,0.0,1.0,6.0 , 0.0\r\n" );
+
+    Wing wing;
+
+    bool success = wing.readSectionsFromCSV( file );
+
+    remove( file );
+
+    if ( !success )
+    {
+        *error = wing.getFileError();
+        return false;
+    }
+
+    if ( wing.getSections() != 2 || wing.getSectionY( 1 ) != 5.0
+      || wing.getSectionTEX( 1 ) != 0.75 || wing.getSectionAngle( 1 ) != -1.0 )
+    {
+        *error = "cross sections data differ";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool testCSVShortRow( string *error )
+{
+    return checkInvalidCSV( "y,le_x,te_x,slope,angle\n0,0,1,6,0\n5,0.15,0.75,6\n6,0.2,0.7,6,0\n", ":3:", error );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool testCSVLongRow( string *error )
+{
+    return checkInvalidCSV( "0,0,1,6,0\n5,0.15,0.75,6,0,1\n6,0.2,0.7,6,0\n", ":2:", error );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool testCSVEmptyField( string *error )
+{
+    return checkInvalidCSV( "0,0,1,6,0\n5,0.15,0.75,6,0\n6,,0.7,6,0\n", ":3:", error );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Binary file is read, modified and saved to the same path, while its
+ * results are still accessed in place.
+ */
+static bool testBinarySaveToSameFile( string *error )
+{
+    const char *file = "bscaero_test.bsc";
+
+    Wing wing;
+
+    if ( !createWing( &wing ) || !wing.compute() || !wing.writeToBinaryFile( file ) )
+    {
+        *error = "cannot write binary file";
+        return false;
+    }
+
+    Wing wing_read;
+
+    if ( !wing_read.readFromFile( file ) )
+    {
+        *error = wing_read.getFileError();
+        return false;
+    }
+
+    wing_read.setParameters( -5.0, 15.0, 21, 20.0, 1.225, 50, 8 );
+
+    if ( !wing_read.writeToDefaultFile() )
+    {
+        *error = "cannot save binary file to the same path";
+        return false;
+    }
+
+    // results mapped from replaced file are still accessible
+    double gamma = wing_read.getGamma( 10, 50 );
+
+    Wing wing_saved;
+
+    bool success = wing_saved.readFromFile( file );
+
+    remove( file );
+
+    if ( !success )
+    {
+        *error = wing_saved.getFileError();
+        return false;
+    }
+
+    if ( wing_saved.getFluidVelocity() != 20.0 || wing_saved.getGamma( 10, 50 ) != gamma
+      || !compareResults( &wing_read, &wing_saved ) )
+    {
+        *error = "saved file content differs";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Binary file header with numbers of iterations exceeding limits (which
+ * would overflow arrays sizes) is rejected.
+ */
+static bool testBinaryInvalidHeader( string *error )
+{
+    const char *file = "bscaero_test.bsc";
+
+    const size_t offsets[] = {
+        offsetof( BinaryFile::Header, sections ),
+        offsetof( BinaryFile::Header, aoa_iterations ),
+        offsetof( BinaryFile::Header, sections_iterations ),
+        offsetof( BinaryFile::Header, fourier_accuracy )
+    };
+
+    const int32_t values[] = { 0x7fffffff, 0x40000000, BinaryFile::maxCount + 1, -1 };
+
+    Wing wing;
+
+    if ( !createWing( &wing ) || !wing.compute() )
+    {
+        *error = "computations failed";
+        return false;
+    }
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        for ( int j = 0; j < 4; j++ )
+        {
+            if ( !wing.writeToBinaryFile( file ) )
+            {
+                *error = "cannot write binary file";
+                return false;
+            }
+
+            fstream fs( file, ios_base::in | ios_base::out | ios_base::binary );
+            fs.seekp( offsets[ i ] );
+            fs.write( (const char*)&values[ j ], sizeof(int32_t) );
+            fs.close();
+
+            Wing wing_read;
+
+            if ( wing_read.readFromFile( file ) )
+            {
+                remove( file );
+                *error = "file with invalid header has been read";
+                return false;
+            }
+        }
+    }
+
+    remove( file );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Text file with numbers of cross sections, angles of attack, spanwise sections
+ * or Fourier series terms above limits is rejected before any arrays are allocated.
+ */
+static bool testTextInvalidParameters( string *error )
+{
+    const char *file = "bscaero_test.dat";
+
+    const char *contents[] = {
+        "1500000000\n-5 15 21 1 10 1.225 50 8\n0\n",
+        "0\n-5 15 2000000000 1 10 1.225 50 8\n0\n",
+        "0\n-5 15 21 1 10 1.225 1500000000 8\n0\n",
+        "0\n-5 15 21 1 10 1.225 50 1500000000\n0\n",
+        "0\n-5 15 21 1 10 1.225 1048577 8\n0\n"
+    };
+
+    for ( int i = 0; i < 5; i++ )
+    {
+        writeTextFile( file, contents[ i ] );
+
+        Wing wing_read;
+
+        bool success = wing_read.readFromFile( file );
+
+        remove( file );
+
+        if ( success )
+        {
+            *error = "file with invalid parameters has been read";
+            return false;
+        }
+
+        if ( string( wing_read.getFileError() ).empty() )
+        {
+            *error = "no error reported";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Text file which results are loaded lazily is saved to the same path
+ * (as slim file), while not yet read results blocks are still in it.
+ */
+static bool testLazySaveToSameFile( string *error )
+{
+    const char *file = "bscaero_test.dat";
+
+    Wing wing;
+
+    if ( !createWing( &wing ) || !wing.compute() || !wing.writeToFile( file ) )
+    {
+        *error = "cannot write text file";
+        return false;
+    }
+
+    Wing wing_read;
+
+    wing_read.setLazyLoading( true );
+
+    if ( !wing_read.readFromFile( file ) )
+    {
+        *error = wing_read.getFileError();
+        return false;
+    }
+
+    wing_read.setSavedResults( Wing::SavedPolar );
+
+    if ( !wing_read.writeToDefaultFile() )
+    {
+        remove( file );
+        *error = "cannot save text file to the same path";
+        return false;
+    }
+
+    // results blocks are read from replaced file
+    bool success = compareResults( &wing, &wing_read );
+
+    Wing wing_saved;
+
+    success = success && wing_saved.readFromFile( file );
+
+    for ( int a = 0; a < wing.getAoA_Iterations() && success; a++ )
+    {
+        success = wing_saved.getLiftCoef( a ) == wing.getLiftCoef( a );
+    }
+
+    remove( file );
+
+    if ( !success )
+    {
+        *error = "results differ after saving file";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Results blocks which cannot be lazily read from truncated file are zeros.
+ */
+static bool testLazyTruncatedFile( string *error )
+{
+    const char *file = "bscaero_test.dat";
+
+    Wing wing;
+
+    if ( !createWing( &wing ) || !wing.compute() || !wing.writeToFile( file ) )
+    {
+        *error = "cannot write text file";
+        return false;
+    }
+
+    // file is truncated right after angles of attack
+    string content;
+    {
+        ifstream fs( file, ios_base::binary );
+        content.assign( istreambuf_iterator< char >( fs ), istreambuf_iterator< char >() );
+    }
+
+    // skipping results marker, saved results flags and compute modes lines
+    size_t pos = content.find( "\n3\n" ) + 3;
+
+    pos = content.find( '\n', content.find( '\n', pos ) + 1 ) + 1;
+    pos = content.find( '\n', pos );
+
+    for ( int a = 0; a < wing.getAoA_Iterations() && pos != string::npos; a++ )
+    {
+        pos = content.find( '\n', pos + 1 );
+    }
+
+    {
+        ofstream fs( file, ios_base::binary | ios_base::trunc );
+        fs << content.substr( 0, pos + 1 );
+    }
+
+    Wing wing_read;
+
+    wing_read.setLazyLoading( true );
+
+    bool success = wing_read.readFromFile( file );
+
+    remove( file );
+
+    if ( !success )
+    {
+        *error = wing_read.getFileError();
+        return false;
+    }
+
+    if ( wing_read.getAoADeg( 1 ) != wing.getAoADeg( 1 ) )
+    {
+        *error = "angles of attack differ";
+        return false;
+    }
+
+    for ( int a = 0; a < wing.getAoA_Iterations(); a++ )
+    {
+        for ( int i = 0; i < wing.getSectionsFullspan(); i++ )
+        {
+            if ( wing_read.getGamma( a, i ) != 0.0 )
+            {
+                *error = "value which cannot be read is not zero";
+                return false;
+            }
+        }
+    }
+
+    if ( string( wing_read.getFileError() ).empty() )
+    {
+        *error = "no error reported";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Results omitted in slim file are recomputed after reading in compute
+ * modes stored in file, not in the reading wing modes.
+ */
+static bool testSlimComputeModes( string *error )
+{
+    const char *file = "bscaero_test.dat";
+
+    Wing wing;
+
+    wing.setSymmetric( true );
+    wing.setSuperposition( true );
+    wing.setSavedResults( Wing::SavedPolar );
+
+    if ( !createWing( &wing ) || !wing.compute() || !wing.writeToFile( file ) )
+    {
+        *error = "cannot write slim file";
+        return false;
+    }
+
+    Wing wing_read;
+
+    bool success = wing_read.readFromFile( file );
+
+    remove( file );
+
+    if ( !success )
+    {
+        *error = wing_read.getFileError();
+        return false;
+    }
+
+    if ( !wing_read.isSymmetric() || !wing_read.isSuperposition() )
+    {
+        *error = "compute modes not read";
+        return false;
+    }
+
+    // circulation is recomputed
+    if ( !compareResults( &wing, &wing_read ) )
+    {
+        *error = "recomputed results differ";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Checks if least-squares compute mode is stored in slim file and results are
+ * recomputed in this mode after reading.
+ */
+static bool testSlimLeastSquares( string *error )
+{
+    const char *file = "bscaero_test.dat";
+
+    Wing wing;
+
+    wing.setLeastSquares( true );
+    wing.setSavedResults( Wing::SavedPolar );
+
+    if ( !createWing( &wing ) || !wing.compute() || !wing.writeToFile( file ) )
+    {
+        *error = "cannot write slim file";
+        return false;
+    }
+
+    Wing wing_read;
+
+    bool success = wing_read.readFromFile( file );
+
+    remove( file );
+
+    if ( !success )
+    {
+        *error = wing_read.getFileError();
+        return false;
+    }
+
+    if ( !wing_read.isLeastSquares() || wing_read.isSymmetric() )
+    {
+        *error = "compute modes not read";
+        return false;
+    }
+
+    // circulation is recomputed
+    if ( !compareResults( &wing, &wing_read ) )
+    {
+        *error = "recomputed results differ";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Writes full results file computed in least-squares mode, reads it, changes
+ * fluid velocity only and checks if results are recomputed in least-squares
+ * mode from equations stored in file.
+ */
+static bool checkLeastSquaresRoundTrip( bool binary, string *error )
+{
+    const char *file = binary ? "bscaero_test.bsc" : "bscaero_test.dat";
+
+    Wing wing;
+
+    wing.setLeastSquares( true );
+
+    bool success = createWing( &wing ) && wing.compute();
+
+    success = success && ( binary ? wing.writeToBinaryFile( file ) : wing.writeToFile( file ) );
+
+    if ( !success )
+    {
+        *error = "cannot write file";
+        return false;
+    }
+
+    Wing wing_read;
+
+    success = wing_read.readFromFile( file );
+
+    remove( file );
+
+    if ( !success )
+    {
+        *error = wing_read.getFileError();
+        return false;
+    }
+
+    if ( !wing_read.isLeastSquares() || wing_read.isSymmetric() || wing_read.isSuperposition() )
+    {
+        *error = "compute modes not read";
+        return false;
+    }
+
+    Wing wing_ref;
+
+    wing_ref.setLeastSquares( true );
+
+    if ( !createWing( &wing_ref ) || !wing_ref.setParameters( -5.0, 15.0, 21, 20.0, 1.225, 50, 8 )
+      || !wing_ref.compute() )
+    {
+        *error = "cannot compute reference wing";
+        return false;
+    }
+
+    if ( !wing_read.setParameters( -5.0, 15.0, 21, 20.0, 1.225, 50, 8 ) || !wing_read.compute() )
+    {
+        *error = "cannot recompute wing read";
+        return false;
+    }
+
+    if ( !compareResults( &wing_ref, &wing_read ) )
+    {
+        *error = "recomputed results differ";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Least-squares compute mode is stored in full text results file.
+ */
+static bool testTextLeastSquares( string *error )
+{
+    return checkLeastSquaresRoundTrip( false, error );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Least-squares compute mode is stored in binary results file.
+ */
+static bool testBinaryLeastSquares( string *error )
+{
+    return checkLeastSquaresRoundTrip( true, error );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Results omitted in slim file which cannot be recomputed (single cross
+ * section) are zeros and error is set.
+ */
+static bool testSlimRecomputeFailure( string *error )
+{
+    const char *file = "bscaero_test.dat";
+
+    Wing wing;
+
+    wing.setSavedResults( Wing::SavedPolar );
+
+    if ( !createWing( &wing ) || !wing.compute() || !wing.writeToFile( file ) )
+    {
+        *error = "cannot write slim file";
+        return false;
+    }
+
+    // removing second cross section
+    string content;
+    {
+        ifstream fs( file, ios_base::binary );
+        content.assign( istreambuf_iterator< char >( fs ), istreambuf_iterator< char >() );
+    }
+
+    size_t first  = content.find( '\n' ) + 1;
+    size_t second = content.find( '\n', first ) + 1;
+    size_t third  = content.find( '\n', second ) + 1;
+
+    writeTextFile( file, ( "1\n" + content.substr( first, second - first ) + content.substr( third ) ).c_str() );
+
+    Wing wing_read;
+
+    bool success = wing_read.readFromFile( file );
+
+    remove( file );
+
+    if ( !success )
+    {
+        *error = wing_read.getFileError();
+        return false;
+    }
+
+    if ( wing_read.getGamma( 10, 50 ) != 0.0 || wing_read.getLiftCoef( 10 ) != 0.0
+      || wing_read.getWingSpanCoef( 50 ) != 0.0 )
+    {
+        *error = "results which cannot be recomputed are not zeros";
+        return false;
+    }
+
+    if ( string( wing_read.getFileError() ).empty() )
+    {
+        *error = "no error reported";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Recomputes wing after fluid velocity change and compares results with
+ * wing computed from scratch.
+ */
+static bool testComputeVelocity( string *error )
+{
+    CacheCapacity cache( 0 );
+
+    Wing wing;
+    Wing wing_ref;
+
+    bool success = createWing( &wing ) && wing.compute()
+                && wing.setParameters( -5.0, 15.0, 21, 20.0, 1.225, 50, 8 ) && wing.compute();
+
+    success = success && createWing( &wing_ref )
+           && wing_ref.setParameters( -5.0, 15.0, 21, 20.0, 1.225, 50, 8 ) && wing_ref.compute();
+
+    if ( !success )
+    {
+        *error = "computations failed";
+        return false;
+    }
+
+    if ( !compareResults( &wing_ref, &wing ) )
+    {
+        *error = "recomputed results differ";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Recomputes wing after angles of attack range change and compares results
+ * with wing computed from scratch.
+ */
+static bool testComputeAoARange( string *error )
+{
+    CacheCapacity cache( 0 );
+
+    Wing wing;
+    Wing wing_ref;
+
+    bool success = createWing( &wing ) && wing.compute()
+                && wing.setParameters( -2.0, 10.0, 13, 10.0, 1.225, 50, 8 ) && wing.compute();
+
+    success = success && createWing( &wing_ref )
+           && wing_ref.setParameters( -2.0, 10.0, 13, 10.0, 1.225, 50, 8 ) && wing_ref.compute();
+
+    if ( !success )
+    {
+        *error = "computations failed";
+        return false;
+    }
+
+    if ( !compareResults( &wing_ref, &wing ) )
+    {
+        *error = "recomputed results differ";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Recomputes wing after enabling superposition mode and compares results with
+ * wing computed from scratch in this mode and with wing computed in default mode.
+ */
+static bool testComputeSuperposition( string *error )
+{
+    CacheCapacity cache( 0 );
+
+    Wing wing;
+    Wing wing_ref;
+    Wing wing_default;
+
+    wing_ref.setSuperposition( true );
+
+    bool success = createWing( &wing ) && wing.compute();
+
+    wing.setSuperposition( true );
+
+    success = success && wing.compute()
+           && createWing( &wing_ref ) && wing_ref.compute()
+           && createWing( &wing_default ) && wing_default.compute();
+
+    if ( !success )
+    {
+        *error = "computations failed";
+        return false;
+    }
+
+    if ( !compareResults( &wing_ref, &wing ) )
+    {
+        *error = "recomputed results differ";
+        return false;
+    }
+
+    if ( !compareResults( &wing_default, &wing, 1.0e-12 ) )
+    {
+        *error = "results differ from default mode";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Compares results of wing computed in symmetric mode with wing computed
+ * in default mode.
+ */
+static bool testComputeSymmetric( string *error )
+{
+    CacheCapacity cache( 0 );
+
+    Wing wing;
+    Wing wing_default;
+
+    wing.setSymmetric( true );
+
+    if ( !createWing( &wing ) || !wing.compute()
+      || !createWing( &wing_default ) || !wing_default.compute() )
+    {
+        *error = "computations failed";
+        return false;
+    }
+
+    if ( !compareResults( &wing_default, &wing, 1.0e-12 ) )
+    {
+        *error = "results differ from default mode";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Recomputes wing after cross section edit and compares results with wing
+ * computed from scratch.
+ */
+static bool testComputeEditSection( string *error )
+{
+    CacheCapacity cache( 0 );
+
+    Wing wing;
+    Wing wing_ref;
+
+    bool success = createWing( &wing ) && wing.compute()
+                && wing.editSectionData( 5.0, 0.2, 0.8, 6.0, -2.0, 1 ) && wing.compute();
+
+    success = success
+           && wing_ref.addSectionData( 0.0, 0.0, 1.0, 6.0,  0.0 )
+           && wing_ref.addSectionData( 5.0, 0.2, 0.8, 6.0, -2.0 )
+           && wing_ref.setParameters( -5.0, 15.0, 21, 10.0, 1.225, 50, 8 )
+           && wing_ref.compute();
+
+    if ( !success )
+    {
+        *error = "computations failed";
+        return false;
+    }
+
+    if ( !compareResults( &wing_ref, &wing ) )
+    {
+        *error = "recomputed results differ";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Results are bit-identical for any number of threads. System is large enough
+ * to be factorized by blocks with trailing submatrix updated by threads.
+ */
+static bool testComputeThreads( string *error )
+{
+    CacheCapacity cache( 0 );
+
+    Wing wing_1;
+    Wing wing_3;
+
+    wing_1.setThreads( 1 );
+    wing_3.setThreads( 3 );
+
+    bool success = createWing( &wing_1 ) && wing_1.setParameters( -5.0, 15.0, 41, 10.0, 1.225, 301, 240 )
+                && createWing( &wing_3 ) && wing_3.setParameters( -5.0, 15.0, 41, 10.0, 1.225, 301, 240 )
+                && wing_1.compute() && wing_3.compute();
+
+    if ( !success )
+    {
+        *error = "computations failed";
+        return false;
+    }
+
+    if ( !compareResults( &wing_1, &wing_3 ) )
+    {
+        *error = "results differ";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Results of wing which reuses cached solution are bit-identical to results
+ * of wing computed with caching disabled.
+ */
+static bool testComputeCache( string *error )
+{
+    Wing wing_uncached;
+    Wing wing_stored;
+    Wing wing_cached;
+
+    bool success = false;
+
+    {
+        CacheCapacity cache( 0 );
+
+        success = createWing( &wing_uncached ) && wing_uncached.compute();
+    }
+
+    {
+        CacheCapacity cache( 32 );
+
+        SolutionCache::instance()->clear();
+
+        success = success
+               && createWing( &wing_stored ) && wing_stored.compute()
+               && createWing( &wing_cached ) && wing_cached.compute();
+    }
+
+    if ( !success )
+    {
+        *error = "computations failed";
+        return false;
+    }
+
+    if ( !compareResults( &wing_uncached, &wing_cached ) )
+    {
+        *error = "cached results differ";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Fills matrix with pseudo-random values (the same on every call). Every other
+ * diagonal element is increased, so factorization swaps some rows but not all.
+ */
+static void createSystem( int size, vector< double > *mtr )
+{
+    unsigned int seed = 12345u;
+
+    mtr->resize( size * size );
+
+    for ( int i = 0; i < size * size; i++ )
+    {
+        seed = seed * 1103515245u + 12345u;
+        (*mtr)[ i ] = (double)( ( seed >> 8 ) % 20001 ) / 10000.0 - 1.0;
+    }
+
+    for ( int i = 0; i < size; i += 2 )
+    {
+        (*mtr)[ i * size + i ] += 2.0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Factorizes matrix by plain unblocked LU with partial pivoting, in the same
+ * operations order as GaussJordan::factorize() for systems NOT factorized by blocks.
+ */
+static void factorizePlain( int size, double *lu, int *piv )
+{
+    for ( int k = 0; k < size; k++ )
+    {
+        int p = k;
+
+        for ( int i = k + 1; i < size; i++ )
+        {
+            if ( fabs( lu[ i * size + k ] ) > fabs( lu[ p * size + k ] ) ) p = i;
+        }
+
+        piv[ k ] = p;
+
+        if ( p != k )
+        {
+            for ( int c = 0; c < size; c++ ) swap( lu[ k * size + c ], lu[ p * size + c ] );
+        }
+
+        double a_kk_inv = 1.0 / lu[ k * size + k ];
+
+        for ( int i = k + 1; i < size; i++ )
+        {
+            double l_ik = ( lu[ i * size + k ] *= a_kk_inv );
+
+            for ( int c = k + 1; c < size; c++ )
+            {
+                lu[ i * size + c ] -= l_ik * lu[ k * size + c ];
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Blocked factorization, with and without threads, is bit-identical to plain
+ * unblocked factorization.
+ */
+static bool testSolverBlocked( string *error )
+{
+    // greater than minimum size factorized by blocks and NOT multiple of block size
+    const int size = 300;
+
+    vector< double > mtr;
+    createSystem( size, &mtr );
+
+    vector< double > lu_plain( mtr );
+    vector< int > piv_plain( size );
+
+    factorizePlain( size, lu_plain.data(), piv_plain.data() );
+
+    ThreadPool pool( 3 );
+
+    for ( int threaded = 0; threaded < 2; threaded++ )
+    {
+        vector< double > lu( mtr );
+        vector< int > piv( size );
+
+        if ( GaussJordan::factorize( size, lu.data(), piv.data(), 1.0e-14, threaded ? &pool : 0 ) != BSC_SUCCESS )
+        {
+            *error = "factorization failed";
+            return false;
+        }
+
+        if ( memcmp( lu.data(), lu_plain.data(), lu.size() * sizeof(double) ) != 0
+          || memcmp( piv.data(), piv_plain.data(), piv.size() * sizeof(int) ) != 0 )
+        {
+            *error = threaded ? "threaded factors differ" : "blocked factors differ";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Compile-time size specialization factors and solutions are bit-identical
+ * to general ones.
+ */
+static bool testSolverFixedSize( string *error )
+{
+    const int size  = 16;
+    const int count = 5;
+
+    if ( !GaussJordan::hasFixedSize( size ) )
+    {
+        *error = "no specialization for tested size";
+        return false;
+    }
+
+    vector< double > mtr;
+    createSystem( size, &mtr );
+
+    vector< double > lu( mtr );
+    vector< double > lu_fixed( mtr );
+    vector< int > piv( size );
+    vector< int > piv_fixed( size );
+
+    if ( GaussJordan::factorize( size, lu.data(), piv.data() ) != BSC_SUCCESS
+      || GaussJordan::factorizeFixed( size, lu_fixed.data(), piv_fixed.data() ) != BSC_SUCCESS )
+    {
+        *error = "factorization failed";
+        return false;
+    }
+
+    if ( memcmp( lu.data(), lu_fixed.data(), lu.size() * sizeof(double) ) != 0
+      || memcmp( piv.data(), piv_fixed.data(), piv.size() * sizeof(int) ) != 0 )
+    {
+        *error = "factors differ";
+        return false;
+    }
+
+    vector< double > rhs( mtr.begin(), mtr.begin() + size * count );
+    vector< double > x( size * count );
+    vector< double > x_fixed( size * count );
+
+    GaussJordan::substitute( size, lu.data(), piv.data(), count, rhs.data(), x.data() );
+    GaussJordan::substituteFixed( size, lu.data(), piv.data(), count, rhs.data(), x_fixed.data() );
+
+    if ( memcmp( x.data(), x_fixed.data(), x.size() * sizeof(double) ) != 0 )
+    {
+        *error = "solutions differ";
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int main( int /*argc*/, char * /*argv*/[] )
+{
+    setlocale( LC_ALL, "C" );
+
+    const Test tests[] =
+    {
+        { "binary/saveToSameFile"  , testBinarySaveToSameFile  },
+        { "binary/invalidHeader"   , testBinaryInvalidHeader   },
+        { "text/invalidParameters" , testTextInvalidParameters },
+        { "lazy/saveToSameFile"    , testLazySaveToSameFile    },
+        { "lazy/truncatedFile"     , testLazyTruncatedFile     },
+        { "csv/valid"              , testCSVValid              },
+        { "csv/shortRow"           , testCSVShortRow           },
+        { "csv/longRow"            , testCSVLongRow            },
+        { "csv/emptyField"         , testCSVEmptyField         },
+        { "slim/computeModes"      , testSlimComputeModes      },
+        { "slim/leastSquares"      , testSlimLeastSquares      },
+        { "text/leastSquares"      , testTextLeastSquares      },
+        { "binary/leastSquares"    , testBinaryLeastSquares    },
+        { "slim/recomputeFailure"  , testSlimRecomputeFailure  },
+        { "compute/velocity"       , testComputeVelocity       },
+        { "compute/aoaRange"       , testComputeAoARange       },
+        { "compute/superposition"  , testComputeSuperposition  },
+        { "compute/symmetric"      , testComputeSymmetric      },
+        { "compute/editSection"    , testComputeEditSection    },
+        { "compute/threads"        , testComputeThreads        },
+        { "compute/cache"          , testComputeCache          },
+        { "solver/blocked"         , testSolverBlocked         },
+        { "solver/fixedSize"       , testSolverFixedSize       }
+    };
+
+    const int count = sizeof(tests) / sizeof(Test);
+    int failed = 0;
+
+    for ( int i = 0; i < count; i++ )
+    {
+        string error;
+
+        if ( tests[ i ].run( &error ) )
+        {
+            cout << "[passed] " << tests[ i ].name << endl;
+        }
+        else
+        {
+            cerr << "[failed] " << tests[ i ].name << ": " << error << endl;
+            failed++;
+        }
+    }
+
+    cout << ( count - failed ) << " of " << count << " tests passed." << endl;
+
+    return ( failed > 0 ) ? 1 : 0;
+}